@@ -50,6 +50,7 @@
 #import <VerovioFramework/calcalignmentpitchposfunctor.h>
 #import <VerovioFramework/calcalignmentxposfunctor.h>
 #import <VerovioFramework/calcarticfunctor.h>
+#import <VerovioFramework/calcbboxfunctor.h>
 #import <VerovioFramework/calcbboxoverflowsfunctor.h>
 #import <VerovioFramework/calcchordnoteheadsfunctor.h>
 #import <VerovioFramework/calcdotsfunctor.h>
@@ -164,6 +165,7 @@
 #import <VerovioFramework/note.h>
 #import <VerovioFramework/num.h>
 #import <VerovioFramework/object.h>
+#import <VerovioFramework/objectarena.h>
 #import <VerovioFramework/octave.h>
 #import <VerovioFramework/options.h>
 #import <VerovioFramework/orig.h>
@@ -183,6 +185,7 @@
 #import <VerovioFramework/plistinterface.h>
 #import <VerovioFramework/positioninterface.h>
 #import <VerovioFramework/preparedatafunctor.h>
+#import <VerovioFramework/profiler.h>
 #import <VerovioFramework/proport.h>
 #import <VerovioFramework/rdg.h>
 #import <VerovioFramework/ref.h>
@@ -206,6 +209,7 @@
 #import <VerovioFramework/sic.h>
 #import <VerovioFramework/slur.h>
 #import <VerovioFramework/smufl.h>
+#import <VerovioFramework/snapshot.h>
 #import <VerovioFramework/space.h>
 #import <VerovioFramework/staff.h>
 #import <VerovioFramework/staffdef.h>
@@ -16,8 +16,15 @@
 %ignore vrv::Toolkit::GetLogString( );
 %ignore vrv::Toolkit::ParseOptions( const std::string & );
 %ignore vrv::Toolkit::ResetLogBuffer( );
+%ignore vrv::Toolkit::RenderAllToSVG( int, bool );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
 %ignore vrv::Toolkit::SetCString( const std::string & );
+%ignore vrv::Toolkit::GetDescriptiveFeaturesObj( const std::string & );
+%ignore vrv::Toolkit::GetElementAttrObj( const std::string & );
+%ignore vrv::Toolkit::GetElementsAtTimeObj( int );
+%ignore vrv::Toolkit::GetMIDIValuesForElementObj( const std::string & );
+%ignore vrv::Toolkit::GetTimesForElementObj( const std::string & );
+%ignore vrv::Toolkit::RenderToTimemapObj( const std::string & = "" );
 
 %module verovio
 %include "std_string.i"
@@ -16,9 +16,24 @@
 %ignore vrv::Toolkit::GetLogString( );
 %ignore vrv::Toolkit::GetOptionsObj( );
 %ignore vrv::Toolkit::ResetLogBuffer( );
+%ignore vrv::Toolkit::RenderAllToSVG( int, bool );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
 %ignore vrv::Toolkit::SetCString( const std::string & );
 
+// Methods returning JSON values converted directly to Python objects (see the typemaps below)
+%ignore vrv::Toolkit::GetDescriptiveFeatures( const std::string & );
+%ignore vrv::Toolkit::GetElementAttr( const std::string & );
+%ignore vrv::Toolkit::GetElementsAtTime( int );
+%ignore vrv::Toolkit::GetMIDIValuesForElement( const std::string & );
+%ignore vrv::Toolkit::GetTimesForElement( const std::string & );
+%ignore vrv::Toolkit::RenderToTimemap( const std::string & = "" );
+%rename("getDescriptiveFeatures") vrv::Toolkit::GetDescriptiveFeaturesObj;
+%rename("getElementAttr") vrv::Toolkit::GetElementAttrObj;
+%rename("getElementsAtTime") vrv::Toolkit::GetElementsAtTimeObj;
+%rename("getMIDIValuesForElement") vrv::Toolkit::GetMIDIValuesForElementObj;
+%rename("getTimesForElement") vrv::Toolkit::GetTimesForElementObj;
+%rename("renderToTimemap") vrv::Toolkit::RenderToTimemapObj;
+
 %feature("autodoc", "1");
 
 // Because we transform the strings to dictionaries, we need this module
@@ -56,26 +71,33 @@ def getDefaultOptions(toolkit) -> dict:
 %}
 
 // Toolkit::GetDescriptiveFeatures
-%feature("shadow") vrv::Toolkit::GetDescriptiveFeatures(const std::string &) %{
+%feature("shadow") vrv::Toolkit::GetDescriptiveFeaturesObj(const std::string &) %{
 def getDescriptiveFeatures(toolkit, options: Optional[dict] = None) -> dict:
     """Return descriptive features as dictionary."""
     if options is None:
         options = {}
-    return json.loads($action(toolkit, json.dumps(options)))
+    return $action(toolkit, json.dumps(options))
 %}
 
 // Toolkit::GetElementAttr
-%feature("shadow") vrv::Toolkit::GetElementAttr(const std::string &) %{
+%feature("shadow") vrv::Toolkit::GetElementAttrObj(const std::string &) %{
 def getElementAttr(toolkit, xml_id: str) -> dict:
     """Return element attributes as dictionary."""
-    return json.loads($action(toolkit, xml_id))
+    return $action(toolkit, xml_id)
+%}
+
+// Toolkit::GetElementsAtPoint
+%feature("shadow") vrv::Toolkit::GetElementsAtPoint(int, int, int) %{
+def getElementsAtPoint(toolkit, page_no: int, x: int, y: int) -> list:
+    """Return array of IDs of elements rendered at a point of a page."""
+    return json.loads($action(toolkit, page_no, x, y))
 %}
 
 // Toolkit::GetElementsAtTime
-%feature("shadow") vrv::Toolkit::GetElementsAtTime(int) %{
+%feature("shadow") vrv::Toolkit::GetElementsAtTimeObj(int) %{
 def getElementsAtTime(toolkit, millisec: int) -> dict:
     """Return array of IDs of elements being currently played."""
-    return json.loads($action(toolkit, millisec))
+    return $action(toolkit, millisec)
 %}
 
 // Toolkit::GetExpansionIdsForElement
@@ -95,10 +117,10 @@ def getMEI(toolkit, options: Optional[dict] = None) -> str:
 %}
 
 // Toolkit::GetMIDIValuesForElement
-%feature("shadow") vrv::Toolkit::GetMIDIValuesForElement(const std::string &) %{
+%feature("shadow") vrv::Toolkit::GetMIDIValuesForElementObj(const std::string &) %{
 def getMIDIValuesForElement(toolkit, xml_id: str) -> dict:
     """Return MIDI values of the element with the ID (xml:id)."""
-    return json.loads($action(toolkit, xml_id))
+    return $action(toolkit, xml_id)
 %}
 
 // Toolkit::GetOptions
@@ -109,10 +131,10 @@ def getOptions(toolkit) -> dict:
 %}
 
 // Toolkit::GetTimesForElement
-%feature("shadow") vrv::Toolkit::GetTimesForElement(const std::string &) %{
+%feature("shadow") vrv::Toolkit::GetTimesForElementObj(const std::string &) %{
 def getTimesForElement(toolkit, xml_id: str) -> dict:
     """Return a dictionary with the following key values for a given note."""
-    return json.loads($action(toolkit, xml_id))
+    return $action(toolkit, xml_id)
 %}
 
 // Toolkit::RedoLayout
@@ -124,6 +146,13 @@ def redoLayout(toolkit, options: Optional[dict] = None) -> None:
     return $action(toolkit, json.dumps(options))
 %}
 
+// Toolkit::RedoEditedLayout
+%feature("shadow") vrv::Toolkit::RedoEditedLayout() %{
+def redoEditedLayout(toolkit) -> list:
+    """Redo the layout of the loaded data after editing it."""
+    return json.loads($action(toolkit))
+%}
+
 // Toolkit::RenderData
 %feature("shadow") vrv::Toolkit::RenderData(const std::string &, const std::string &) %{
 def renderData(toolkit, data, options: dict) -> str:
@@ -146,12 +175,12 @@ def renderToExpansionMapFile(toolkit, filename: str) -> bool:
 %}
 
 // Toolkit::RenderToTimemap
-%feature("shadow") vrv::Toolkit::RenderToTimemap(const std::string & = "") %{
+%feature("shadow") vrv::Toolkit::RenderToTimemapObj(const std::string & = "") %{
 def renderToTimemap(toolkit, options: Optional[dict] = None) -> list:
     """Render a document to a timemap."""
     if options is None:
         options = {}
-    return json.loads($action(toolkit, json.dumps(options)))
+    return $action(toolkit, json.dumps(options))
 %}
 
 // Toolkit::RenderToTimemapFile
@@ -197,13 +226,86 @@ def validatePAE(toolkit, data: Union[str, dict]) -> dict:
 
 %module(package="verovio") verovio
 %include "std_string.i"
+
+// JSON values are converted to dictionaries and lists without being stringified
+%feature("novaluewrapper") jsonxx::Array;
+%feature("novaluewrapper") jsonxx::Object;
+%typemap(out) jsonxx::Array, jsonxx::Object {
+    $result = JsonToPython((const $1_basetype &)$1);
+}
+
 %include "../../include/vrv/toolkit.h"
 %include "../../include/vrv/toolkitdef.h"
 
 %{
+    #include <cmath>
+
     #include "../../include/vrv/toolkit.h"
     #include "../../include/vrv/toolkitdef.h"
+    #include "../../include/json/jsonxx.h"
     
     using namespace vrv;
     using namespace std;
+
+    static PyObject *JsonToPython(const jsonxx::Value &value);
+
+    // Convert a JSON array to a list
+    static PyObject *JsonToPython(const jsonxx::Array &array)
+    {
+        PyObject *list = PyList_New(array.size());
+        if (!list) return NULL;
+        for (size_t i = 0; i < array.size(); ++i) {
+            PyObject *item = JsonToPython(*array.values().at(i));
+            if (!item) {
+                Py_DECREF(list);
+                return NULL;
+            }
+            PyList_SET_ITEM(list, i, item);
+        }
+        return list;
+    }
+
+    // Convert a JSON object to a dictionary
+    static PyObject *JsonToPython(const jsonxx::Object &object)
+    {
+        PyObject *dict = PyDict_New();
+        if (!dict) return NULL;
+        for (const auto &[key, value] : object.kv_map()) {
+            PyObject *item = JsonToPython(*value);
+            if (!item || PyDict_SetItemString(dict, key.c_str(), item) != 0) {
+                Py_XDECREF(item);
+                Py_DECREF(dict);
+                return NULL;
+            }
+            Py_DECREF(item);
+        }
+        return dict;
+    }
+
+    // Convert a JSON value with the types json.loads would give for its stringified version
+    static PyObject *JsonToPython(const jsonxx::Value &value)
+    {
+        switch (value.type_) {
+            case jsonxx::Value::NUMBER_: {
+                const long double number = value.number_value_;
+                // Fixed precision values are written with decimals
+                if (value.precision_ != -1) {
+                    const long double factor = std::pow(10.0L, value.precision_);
+                    return PyFloat_FromDouble((double)(std::round(number * factor) / factor));
+                }
+                // Integral values are written without exponent up to the precision used
+                if (std::isfinite(number) && (number == std::trunc(number)) && (std::fabs(number) < 1e19L)) {
+                    return PyLong_FromDouble((double)number);
+                }
+                return PyFloat_FromDouble((double)number);
+            }
+            case jsonxx::Value::STRING_:
+                return PyUnicode_DecodeUTF8(
+                    value.string_value_->c_str(), value.string_value_->size(), "surrogateescape");
+            case jsonxx::Value::BOOL_: return PyBool_FromLong(value.bool_value_);
+            case jsonxx::Value::ARRAY_: return JsonToPython(*value.array_value_);
+            case jsonxx::Value::OBJECT_: return JsonToPython(*value.object_value_);
+            default: Py_RETURN_NONE;
+        }
+    }
 %}
@@ -36,6 +36,9 @@ function getToolkitFunction(VerovioModule, method) {
     // char *getElementAttr(Toolkit *ic, const char *xmlId)
     mapping.getElementAttr = VerovioModule.cwrap("vrvToolkit_getElementAttr", "string", ["number", "string"]);
 
+    // char *getElementsAtPoint(Toolkit *ic, int pageNo, int x, int y)
+    mapping.getElementsAtPoint = VerovioModule.cwrap("vrvToolkit_getElementsAtPoint", "string", ["number", "number", "number", "number"]);
+
     // char *getElementsAtTime(Toolkit *ic, int time)
     mapping.getElementsAtTime = VerovioModule.cwrap("vrvToolkit_getElementsAtTime", "string", ["number", "number"]);
 
@@ -72,6 +75,12 @@ function getToolkitFunction(VerovioModule, method) {
     // int getPageWithElement(Toolkit *ic, const char *xmlId)
     mapping.getPageWithElement = VerovioModule.cwrap("vrvToolkit_getPageWithElement", "number", ["number", "string"]);
 
+    // char *getProfile(Toolkit *ic)
+    mapping.getProfile = VerovioModule.cwrap("vrvToolkit_getProfile", "string", ["number"]);
+
+    // char *getProfileTrace(Toolkit *ic)
+    mapping.getProfileTrace = VerovioModule.cwrap("vrvToolkit_getProfileTrace", "string", ["number"]);
+
     // double getTimeForElement(Toolkit *ic, const char *xmlId)
     mapping.getTimeForElement = VerovioModule.cwrap("vrvToolkit_getTimeForElement", "number", ["number", "string"]);
 
@@ -93,6 +102,9 @@ function getToolkitFunction(VerovioModule, method) {
     // bool loadZipDataBuffer(Toolkit *ic, const unsigned char *data, int length)
     mapping.loadZipDataBuffer = VerovioModule.cwrap("vrvToolkit_loadZipDataBuffer", "number", ["number", "number", "number"]);
 
+    // char *redoEditedLayout(Toolkit *ic)
+    mapping.redoEditedLayout = VerovioModule.cwrap("vrvToolkit_redoEditedLayout", "string", ["number"]);
+
     // void redoLayout(Toolkit *ic)
     mapping.redoLayout = VerovioModule.cwrap("vrvToolkit_redoLayout", null, ["number", "string"]);
 
@@ -129,6 +141,12 @@ function getToolkitFunction(VerovioModule, method) {
     // void setOptions(Toolkit *ic, const char *options) 
     mapping.setOptions = VerovioModule.cwrap("vrvToolkit_setOptions", null, ["number", "string"]);
 
+    // void startProfiling(Toolkit *ic)
+    mapping.startProfiling = VerovioModule.cwrap("vrvToolkit_startProfiling", null, ["number"]);
+
+    // void stopProfiling(Toolkit *ic)
+    mapping.stopProfiling = VerovioModule.cwrap("vrvToolkit_stopProfiling", null, ["number"]);
+
     // char *validatePAE(Toolkit *ic, const char *options)
     mapping.validatePAE = VerovioModule.cwrap("vrvToolkit_validatePAE", "string", ["number", "string"]);
 
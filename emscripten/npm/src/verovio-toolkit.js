@@ -55,6 +55,10 @@ export class VerovioToolkit {
         return JSON.parse(this.proxy.getElementAttr(this.ptr, xmlId));
     }
 
+    getElementsAtPoint(pageNo, x, y) {
+        return JSON.parse(this.proxy.getElementsAtPoint(this.ptr, pageNo, x, y));
+    }
+
     getElementsAtTime(millisec) {
         return JSON.parse(this.proxy.getElementsAtTime(this.ptr, millisec));
     }
@@ -117,6 +121,14 @@ export class VerovioToolkit {
         return this.proxy.getPageWithElement(this.ptr, xmlId);
     }
 
+    getProfile() {
+        return JSON.parse(this.proxy.getProfile(this.ptr));
+    }
+
+    getProfileTrace() {
+        return JSON.parse(this.proxy.getProfileTrace(this.ptr));
+    }
+
     getTimeForElement(xmlId) {
         return this.proxy.getTimeForElement(this.ptr, xmlId);
     }
@@ -151,6 +163,10 @@ export class VerovioToolkit {
         return res;
     }
 
+    redoEditedLayout() {
+        return JSON.parse(this.proxy.redoEditedLayout(this.ptr));
+    }
+
     redoLayout(options = {}) {
         this.proxy.redoLayout(this.ptr, JSON.stringify(options));
     }
@@ -200,6 +216,14 @@ export class VerovioToolkit {
         return this.proxy.setOptions(this.ptr, JSON.stringify(options));
     }
 
+    startProfiling() {
+        this.proxy.startProfiling(this.ptr);
+    }
+
+    stopProfiling() {
+        this.proxy.stopProfiling(this.ptr);
+    }
+
     validatePAE(data) {
         if (data instanceof Object) {
             data = JSON.stringify(data);
@@ -0,0 +1,131 @@
+"""
+Generate the binary glyph tables loaded by Verovio instead of parsing the XML bounding box files.
+
+For each font XML file (e.g., data/Bravura.xml or data/text/Times.xml) a file with the same name
+and a .bin extension is written next to it. Verovio falls back to the XML file when the binary
+file is missing or out of date, so the binary files must be regenerated whenever the XML files change.
+
+Usage: python3 generate_binary.py [data_dir]
+
+The format is little-endian and must be kept in sync with Resources::LoadBinaryFont:
+
+    header (32 bytes)
+        char[4] magic "VRVG"
+        uint32  format version
+        uint32  size in bytes of the XML file the table was generated from
+        int32   units per em
+        uint32  number of glyph records
+        uint32  number of anchor records
+        uint32  size of the string table
+        uint32  reserved (0)
+    glyph records (40 bytes each)
+        uint32  code
+        uint32  offset of the code string (the 'c' attribute)
+        uint32  offset of the glyph name (the 'n' attribute), or 0xFFFFFFFF if missing
+        uint32  index of the first anchor record
+        uint32  number of anchor records
+        float32 x, y, w, h, h-a-x
+    anchor records (12 bytes each)
+        uint32  offset of the anchor name
+        float32 x, y
+    string table
+        NUL-terminated UTF-8 strings, starting with an empty string at offset 0
+"""
+
+import struct
+import sys
+import xml.etree.ElementTree as Et
+from pathlib import Path
+
+MAGIC = b"VRVG"
+VERSION = 1
+NO_STRING = 0xFFFFFFFF
+
+HEADER = struct.Struct("<4sIIiIIII")
+GLYPH = struct.Struct("<IIIIIfffff")
+ANCHOR = struct.Struct("<Iff")
+
+
+class StringTable:
+    def __init__(self) -> None:
+        self.data = bytearray(b"\0")
+        self.offsets: dict = {"": 0}
+
+    def add(self, value: str) -> int:
+        if value not in self.offsets:
+            self.offsets[value] = len(self.data)
+            self.data += value.encode("utf-8") + b"\0"
+        return self.offsets[value]
+
+
+def float_attribute(node: Et.Element, name: str) -> float:
+    # Missing values default to 0.0, as in Resources::LoadFont
+    value = node.get(name)
+    return float(value) if value is not None else 0.0
+
+
+def generate(xml_path: Path) -> None:
+    root = Et.parse(xml_path).getroot()
+    if root.get("units-per-em") is None:
+        print(f"Skipping {xml_path}: no units-per-em attribute")
+        return
+
+    strings = StringTable()
+    glyphs = bytearray()
+    anchors = bytearray()
+    glyph_count = 0
+    anchor_count = 0
+
+    for glyph in root.findall("g"):
+        code_str = glyph.get("c")
+        if code_str is None:
+            continue
+        name = glyph.get("n")
+        first_anchor = anchor_count
+        for anchor in glyph.findall("a"):
+            anchor_name = anchor.get("n")
+            if anchor_name is None:
+                continue
+            anchors += ANCHOR.pack(
+                strings.add(anchor_name),
+                float_attribute(anchor, "x"),
+                float_attribute(anchor, "y"),
+            )
+            anchor_count += 1
+        glyphs += GLYPH.pack(
+            int(code_str, 16),
+            strings.add(code_str),
+            strings.add(name) if name is not None else NO_STRING,
+            first_anchor,
+            anchor_count - first_anchor,
+            float_attribute(glyph, "x"),
+            float_attribute(glyph, "y"),
+            float_attribute(glyph, "w"),
+            float_attribute(glyph, "h"),
+            float_attribute(glyph, "h-a-x"),
+        )
+        glyph_count += 1
+
+    header = HEADER.pack(
+        MAGIC,
+        VERSION,
+        xml_path.stat().st_size,
+        int(root.get("units-per-em", "0")),
+        glyph_count,
+        anchor_count,
+        len(strings.data),
+        0,
+    )
+    bin_path = xml_path.with_suffix(".bin")
+    bin_path.write_bytes(header + glyphs + anchors + strings.data)
+    print(f"Generated {bin_path} ({glyph_count} glyphs)")
+
+
+def main() -> None:
+    data_dir = Path(sys.argv[1] if len(sys.argv) > 1 else "../data")
+    for xml_path in sorted(data_dir.glob("*.xml")) + sorted(data_dir.glob("text/*.xml")):
+        generate(xml_path)
+
+
+if __name__ == "__main__":
+    main()
@@ -150,7 +150,9 @@ class Object {
   Object &operator<<(const Value &value);
   Object &operator<<(const Object &value);
   Object &operator=(const Object &value);
+  Object &operator=(Object &&value);
   Object(const Object &other);
+  Object(Object &&other);
   Object(const std::string &key, const Value &value);
   template<size_t N>
   Object(const char (&key)[N], const Value &value) {
@@ -203,7 +205,9 @@ class Array {
   Array &operator<<(const Value &value);
   Array &operator=(const Array &other);
   Array &operator=(const Value &value);
+  Array &operator=(Array &&other);
   Array(const Array &other);
+  Array(Array &&other);
   Array(const Value &value);
  protected:
   static bool parse(std::istream& input, Array& array);
@@ -12,6 +12,21 @@
 
 namespace vrv {
 
+//----------------------------------------------------------------------------
+// OverflowBoxesIndex
+//----------------------------------------------------------------------------
+
+/**
+ * This struct holds the spatial indexes of the overflowing boxes above and below a staff, with the number of boxes
+ * already indexed. This should be used solely with AdjustFloatingPositionersFunctor.
+ */
+struct OverflowBoxesIndex {
+    BoundingBoxIndex m_above;
+    BoundingBoxIndex m_below;
+    int m_aboveCount = 0;
+    int m_belowCount = 0;
+};
+
 //----------------------------------------------------------------------------
 // AdjustFloatingPositionersFunctor
 //----------------------------------------------------------------------------
@@ -45,7 +60,17 @@ public:
 protected:
     //
 private:
-    //
+    /**
+     * Return the spatial index of the overflowing boxes above or below the staff.
+     * The index is created for the staff when first needed and the boxes added since the last call are indexed.
+     */
+    BoundingBoxIndex &GetOverflowIndex(StaffAlignment *staffAlignment, bool above, int drawingUnit);
+
+    /**
+     * Add an overflowing box to an index, with the extent checked by FloatingPositioner::HasHorizontalOverlapWith
+     */
+    void AddToIndex(BoundingBoxIndex &index, BoundingBox *box) const;
+
 public:
     //
 private:
@@ -53,6 +78,10 @@ private:
     ClassId m_classId;
     // Indicates if we are processing floating objects to be put in between the staff
     bool m_inBetween;
+    // The spatial indexes of the overflowing boxes of the staves in the system being processed
+    std::map<const StaffAlignment *, OverflowBoxesIndex> m_overflowIndexes;
+    // The boxes found in the index
+    ArrayOfBoundingBoxes m_overlappingBoxes;
 };
 
 //----------------------------------------------------------------------------
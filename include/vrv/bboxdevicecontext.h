@@ -143,6 +143,13 @@ public:
     void EndPage() override;
     ///@}
 
+    /**
+     * Update the content bounding box of the objects being drawn with the one of an object that was calculated
+     * instead of being drawn (see CalcBBoxFunctor).
+     * Return false when this is not possible because the graphic is deactivated or rotated.
+     */
+    bool UpdateWithContentBB(const Object *object);
+
     bool UpdateHorizontalValues() { return (m_update != BBOX_VERTICAL_ONLY); }
     bool UpdateVerticalValues() { return (m_update != BBOX_HORIZONTAL_ONLY); }
 
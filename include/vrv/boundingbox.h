@@ -8,6 +8,8 @@
 #ifndef __VRV_BOUNDING_BOX_H__
 #define __VRV_BOUNDING_BOX_H__
 
+#include <array>
+
 //----------------------------------------------------------------------------
 
 #include "vrvdef.h"
@@ -391,6 +393,88 @@ private:
     bool m_increasing;
 };
 
+//----------------------------------------------------------------------------
+// BoundingBoxIndex
+//----------------------------------------------------------------------------
+
+/**
+ * This class is a spatial index of bounding boxes.
+ * The boxes are added with an extent and registered in the columns of fixed width it covers.
+ * This makes it possible to find the boxes overlapping a horizontal range or a point without looking at all of them.
+ * Extents beyond the range of the index are registered in its first or last column.
+ */
+class BoundingBoxIndex {
+public:
+    /**
+     * @name Constructors, destructors, reset methods
+     * Reset method removes all the boxes and sets the range and the column width
+     */
+    ///@{
+    BoundingBoxIndex();
+    virtual ~BoundingBoxIndex(){};
+    void Reset(int left, int right, int columnWidth);
+    ///@}
+
+    /**
+     * Remove all the boxes
+     */
+    void Clear();
+
+    /**
+     * Check if the index has boxes
+     */
+    bool IsEmpty() const { return (m_boxes.empty()); }
+
+    /**
+     * Add a box with its extent.
+     * The vertical extent is used only for finding the boxes at a point.
+     */
+    void Add(BoundingBox *box, int x1, int x2, int y1 = 0, int y2 = 0);
+
+    /**
+     * Find the boxes with an horizontal extent overlapping x1 to x2 (inclusive).
+     * The boxes are returned in the order they were added.
+     */
+    void FindHorizontalOverlaps(int x1, int x2, ArrayOfBoundingBoxes &boxes) const;
+
+    /**
+     * Find the boxes with an extent enclosing the point.
+     * The boxes are returned in the order they were added.
+     */
+    void FindAt(int x, int y, ArrayOfBoundingBoxes &boxes) const;
+
+private:
+    /**
+     * Return the column for a x position
+     */
+    int GetColumn(int x) const;
+
+    /**
+     * Fill the indexes of the boxes registered in the columns from x1 to x2, in increasing order
+     */
+    void FindCandidates(int x1, int x2, std::vector<int> &candidates) const;
+
+public:
+    //
+private:
+    /**
+     * The range and the column width
+     */
+    int m_left;
+    int m_columnWidth;
+
+    /**
+     * The indexes of the boxes registered in each column, in increasing order
+     */
+    std::vector<std::vector<int>> m_columns;
+
+    /**
+     * The boxes and their extent (x1, x2, y1, y2)
+     */
+    ArrayOfBoundingBoxes m_boxes;
+    std::vector<std::array<int, 4>> m_extents;
+};
+
 } // namespace vrv
 
 #endif
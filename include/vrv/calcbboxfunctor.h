@@ -0,0 +1,120 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        calcbboxfunctor.h
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_CALCBBOXFUNCTOR_H__
+#define __VRV_CALCBBOXFUNCTOR_H__
+
+#include "functor.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// CalcBBoxFunctor
+//----------------------------------------------------------------------------
+
+/**
+ * This class calculates the bounding boxes of a layer element and of its descendants from the glyph metrics,
+ * without drawing them into a BBoxDeviceContext.
+ * The values are the ones the View would obtain for the elements it supports. Any other element stops the
+ * processing, in which case the layer element has to be drawn (see View::CalcLayerElementBBox).
+ */
+class CalcBBoxFunctor : public DocFunctor {
+public:
+    /**
+     * @name Constructors, destructors
+     */
+    ///@{
+    CalcBBoxFunctor(Doc *doc, Staff *staff);
+    virtual ~CalcBBoxFunctor() = default;
+    ///@}
+
+    /*
+     * Abstract base implementation
+     */
+    bool ImplementsEndInterface() const override { return true; }
+
+    /*
+     * Return true if the bounding boxes of all the elements processed have been calculated
+     */
+    bool IsCalculated() const { return m_calculated; }
+
+    /*
+     * Keep the values calculated in order to compare them with the ones obtained by drawing
+     */
+    void SetCheck(bool check) { m_check = check; }
+
+    /*
+     * Compare the values kept with the current ones of the elements and log a warning for each difference.
+     * Return the number of elements with a difference.
+     */
+    int CheckBoundingBoxes() const;
+
+    /*
+     * Functor interface
+     */
+    ///@{
+    FunctorCode VisitAccid(Accid *accid) override;
+    FunctorCode VisitArtic(Artic *artic) override;
+    FunctorCode VisitChord(Chord *chord) override;
+    FunctorCode VisitDots(Dots *dots) override;
+    FunctorCode VisitFlag(Flag *flag) override;
+    FunctorCode VisitLayerElementEnd(LayerElement *layerElement) override;
+    FunctorCode VisitNote(Note *note) override;
+    FunctorCode VisitObject(Object *object) override;
+    FunctorCode VisitRest(Rest *rest) override;
+    FunctorCode VisitStem(Stem *stem) override;
+    ///@}
+
+protected:
+    //
+private:
+    /**
+     * Start the calculation of an element, as BBoxDeviceContext::StartGraphic does.
+     * The staff is the one used for its children.
+     */
+    void StartElement(LayerElement *element, Staff *staff);
+
+    /**
+     * Keep the values of an element when checking
+     */
+    void KeepBoundingBox(const LayerElement *element);
+
+    /**
+     * Update the self bounding box of the current element and the content bounding box of all the elements
+     * being calculated, as BBoxDeviceContext::UpdateBB does. Coordinates are logical ones.
+     */
+    void UpdateBB(int x1, int y1, int x2, int y2, char32_t glyph = 0, int pointSize = 0);
+
+    /**
+     * @name Calculate the primitives, with the same parameters and rounding as in the View
+     */
+    ///@{
+    void CalcSmuflString(
+        int x, int y, const std::u32string &str, bool center, int staffSize, bool dimin, bool setBBGlyph = false);
+    void CalcLine(int x1, int y1, int x2, int y2, int width);
+    void CalcDotsPart(int x, int y, unsigned char dots, const Staff *staff, bool dimin);
+    ///@}
+
+public:
+    //
+private:
+    // The elements being calculated and the staff used for their children
+    std::vector<std::pair<LayerElement *, Staff *>> m_elements;
+    // The staff of the element processed
+    Staff *m_staff;
+    // False as soon as an element cannot be calculated
+    bool m_calculated;
+    // Indicates that only the vertical values are updated
+    bool m_deactivatedX;
+    // The values kept when checking
+    bool m_check;
+    std::vector<std::pair<const LayerElement *, std::vector<int>>> m_checkValues;
+};
+
+} // namespace vrv
+
+#endif // __VRV_CALCBBOXFUNCTOR_H__
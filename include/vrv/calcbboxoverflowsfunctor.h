@@ -53,6 +53,55 @@ private:
     //
 };
 
+//----------------------------------------------------------------------------
+// EstimateBBoxOverflowsFunctor
+//----------------------------------------------------------------------------
+
+/**
+ * This class estimates the overflows (above and below) of each staff alignment without the bounding boxes.
+ * It uses the position of the notes, rests and stems set by the horizontal layout, and adds a line
+ * for each class of floating elements placed above or below the staff.
+ */
+class EstimateBBoxOverflowsFunctor : public DocFunctor {
+public:
+    /**
+     * @name Constructors, destructors
+     */
+    ///@{
+    EstimateBBoxOverflowsFunctor(Doc *doc);
+    virtual ~EstimateBBoxOverflowsFunctor() = default;
+    ///@}
+
+    /*
+     * Abstract base implementation
+     */
+    bool ImplementsEndInterface() const override { return true; }
+
+    /*
+     * Functor interface
+     */
+    ///@{
+    FunctorCode VisitControlElement(ControlElement *controlElement) override;
+    FunctorCode VisitLayerElement(LayerElement *layerElement) override;
+    FunctorCode VisitMeasure(Measure *measure) override;
+    FunctorCode VisitStaff(Staff *staff) override;
+    FunctorCode VisitSystemEnd(System *system) override;
+    ///@}
+
+protected:
+    //
+private:
+    //
+public:
+    //
+private:
+    // The current measure
+    Measure *m_currentMeasure;
+    // The classes of the floating elements above and below each staff alignment of the system
+    std::map<StaffAlignment *, std::set<ClassId>> m_classesAbove;
+    std::map<StaffAlignment *, std::set<ClassId>> m_classesBelow;
+};
+
 } // namespace vrv
 
 #endif // __VRV_CALCBBOXOVERFLOWSFUNCTOR_H__
@@ -183,6 +183,21 @@ public:
     }
 };
 
+//----------------------------------------------------------------------------
+// HasSelfBBComparison
+//----------------------------------------------------------------------------
+
+/**
+ * This class evaluates if the object has a self bounding box.
+ */
+class HasSelfBBComparison : public Comparison {
+
+public:
+    HasSelfBBComparison() : Comparison() { m_supportReverse = true; }
+
+    bool operator()(const Object *object) override { return Result(object->HasSelfBB()); }
+};
+
 //----------------------------------------------------------------------------
 // IsEmptyComparison
 //----------------------------------------------------------------------------
@@ -19,17 +19,51 @@ namespace smf {
 class MidiFile;
 }
 
+namespace jsonxx {
+class Array;
+class Object;
+} // namespace jsonxx
+
 namespace vrv {
 
 class DocSelection;
 class FontInfo;
 class Glyph;
+class ObjectArena;
 class Pages;
 class Page;
 class Score;
 
 enum DocType { Raw = 0, Rendering, Transcription, Facs };
 
+//----------------------------------------------------------------------------
+// CastOffRecord
+//----------------------------------------------------------------------------
+
+/**
+ * The types of records describing the cast-off layout of a document (see Doc::GetCastOffLayout)
+ */
+enum CastOffRecordType : uint32_t {
+    CASTOFF_PAGE = 0,
+    CASTOFF_SYSTEM,
+    CASTOFF_PAGE_CHILD,
+    CASTOFF_SYSTEM_CHILD,
+    CASTOFF_SLUR
+};
+
+/**
+ * A record of the cast-off layout.
+ * Records for children have the ClassId of the child as value, and records for systems have their cast-off widths.
+ * Records for slurs have the curve direction determined when casting off as value.
+ * The fields have a fixed size so records can be written as they are (see Snapshot).
+ */
+struct CastOffRecord {
+    uint32_t m_type;
+    uint32_t m_value;
+    int32_t m_totalWidth;
+    int32_t m_justifiableWidth;
+};
+
 //----------------------------------------------------------------------------
 // Doc
 //----------------------------------------------------------------------------
@@ -81,6 +115,16 @@ public:
     Resources &GetResourcesForModification() { return m_resources; }
     ///@}
 
+    /**
+     * Enable or disable the arena in which the objects of the document are allocated (see ObjectArena).
+     * The arena has to be made current with an ObjectArenaScope, which Toolkit does when loading and laying out.
+     * Objects already allocated are not moved, and disabling it only releases it once they are all deleted.
+     */
+    ///@{
+    void SetObjectArena(bool useObjectArena);
+    ObjectArena *GetObjectArena() { return m_objectArena; }
+    ///@}
+
     /**
      * Generate a document scoreDef when none is provided.
      * This only looks at the content first system of the document.
@@ -277,6 +321,7 @@ public:
      * Run trough all the layers and fill the timemap file content.
      */
     bool ExportTimemap(std::string &output, bool includeRests, bool includeMeasures);
+    bool ExportTimemap(jsonxx::Array &output, bool includeRests, bool includeMeasures);
 
     /**
      *  Extract expansionMap from the document to JSON string.
@@ -287,6 +332,7 @@ public:
      * Extract music features to JSON string.
      */
     bool ExportFeatures(std::string &output, const std::string &options);
+    bool ExportFeatures(jsonxx::Object &output, const std::string &options);
 
     /**
      * Set the initial scoreDef of each page.
@@ -345,12 +391,35 @@ public:
      */
     void UnCastOffDoc(bool resetCache = true);
 
+    /**
+     * Lay out again horizontally the measures modified by the editor (see Measure::SetDirty) and update the cached
+     * horizontal layout, shifting the cached position of the measures following them in the same score.
+     * Only the pages with modified measures are laid out, so casting off the document again with the cache does
+     * not require the horizontal layout of the entire document.
+     * Return false if the document is not cast off or if the layout of a modified measure is not cached.
+     */
+    bool LayOutDirtyMeasures();
+
     /**
      * Cast off of the entire document according to the encoded data (pb and sb).
      * Does not perform any check on the presence and / or validity of such data.
      */
     void CastOffEncodingDoc();
 
+    /**
+     * Get the cast-off layout of the document, i.e., its pages and systems with the type of their content.
+     * The curve direction of the slurs is added since it depends on the layout of the document before cast-off.
+     * Nothing is returned if the document is not cast off.
+     */
+    void GetCastOffLayout(std::vector<CastOffRecord> &layout) const;
+
+    /**
+     * Cast off the entire document according to a layout obtained with GetCastOffLayout.
+     * This replaces the cast-off for a document reloaded with the same content and the same options.
+     * Return false and leave the document unchanged if the layout does not match the content.
+     */
+    bool CastOffLayoutDoc(const std::vector<CastOffRecord> &layout);
+
     /**
      * Convert the doc from score-based to page-based MEI.
      * Containers will be converted to systemMilestone / systemMilestoneEnd.
@@ -427,14 +496,16 @@ public:
     /**
      * Return the width adjusted to the content of the current drawing page.
      * This includes the appropriate left and right margins.
+     * Another page can be given when drawing pages concurrently without changing the drawing page.
      */
-    int GetAdjustedDrawingPageWidth() const;
+    int GetAdjustedDrawingPageWidth(const Page *page = NULL) const;
 
     /**
      * Return the height adjusted to the content of the current drawing page.
      * This includes the appropriate top and bottom margin (using top as bottom).
+     * Another page can be given when drawing pages concurrently without changing the drawing page.
      */
-    int GetAdjustedDrawingPageHeight() const;
+    int GetAdjustedDrawingPageHeight(const Page *page = NULL) const;
 
     /**
      * Setter for markup flag. See corresponding enum in vrvdef.h
@@ -474,6 +545,15 @@ public:
      */
     bool IsCastOff() const { return m_isCastOff; }
 
+    /**
+     * Look for an element in the id index of the document.
+     * The index is rebuilt lazily when the object trees have been modified since it was built.
+     * In order to avoid rebuilding it when looking up while the document is being built, this is done only on the
+     * second lookup after a modification. Returns false if the index cannot be used or if the id is not unique.
+     * Otherwise, element is set to the element with the id or to NULL if the id is not in the document.
+     */
+    bool FindByID(const std::string &id, const Object *&element) const;
+
     /**
      * @name Methods for managing a selection.
      */
@@ -520,6 +600,11 @@ private:
      */
     void CollectVisibleScores();
 
+    /**
+     * Rebuild the id index of the document
+     */
+    void BuildIDIndex() const;
+
 public:
     Page *m_selectionPreceding;
     Page *m_selectionFollowing;
@@ -628,12 +713,15 @@ private:
     int m_drawingLyricFontSize;
     /** Fingering font size*/
     int m_fingeringFontSize;
-    /** Current music font */
-    FontInfo m_drawingSmuflFont;
-    /** Current lyric font */
-    FontInfo m_drawingLyricFont;
-    /** Current fingering font */
-    FontInfo m_fingeringFont;
+    /**
+     * @name Current music, lyric and fingering fonts
+     * They are thread local since pages can be drawn concurrently (see Toolkit::RenderAllToSVG)
+     */
+    ///@{
+    static thread_local FontInfo s_drawingSmuflFont;
+    static thread_local FontInfo s_drawingLyricFont;
+    static thread_local FontInfo s_fingeringFont;
+    ///@}
 
     /**
      * A flag to indicate whether the currentScoreDef has been set or not.
@@ -689,6 +777,19 @@ private:
 
     /** Facsimile information */
     Facsimile *m_facsimile;
+
+    /**
+     * The id index used by Doc::FindByID, with the tree revision it was built for.
+     * The stale revision is the one for which a lookup was last made without rebuilding the index.
+     */
+    ///@{
+    mutable MapOfStrConstObjects m_idIndex;
+    mutable uint64_t m_idIndexRevision;
+    mutable uint64_t m_idIndexStaleRevision;
+    ///@}
+
+    /** The arena for allocating the objects, NULL if not used */
+    ObjectArena *m_objectArena;
 };
 
 } // namespace vrv
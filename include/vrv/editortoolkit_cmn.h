@@ -9,8 +9,11 @@
 #define __VRV_EDITOR_TOOLKIT_CMN_H__
 
 #include <cmath>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 //--------------------------------------------------------------------------------
 
@@ -28,7 +31,7 @@ namespace vrv {
 
 class EditorToolkitCMN : public EditorToolkit {
 public:
-    EditorToolkitCMN(Doc *doc, View *view) : EditorToolkit(doc, view) {}
+    EditorToolkitCMN(Doc *doc, View *view) : EditorToolkit(doc, view) { m_isBatch = false; }
     bool ParseEditorAction(const std::string &json_editorAction) override
     {
         return ParseEditorAction(json_editorAction, false);
@@ -37,11 +40,31 @@ public:
     std::string EditInfo() override;
 
 protected:
+    /**
+     * An action of a batch, parsed before the batch is applied
+     */
+    struct BatchAction {
+        std::string m_action;
+        std::string m_elementId;
+        std::string m_elementType;
+        std::string m_startid;
+        std::string m_endid;
+        std::string m_attribute;
+        std::string m_value;
+        int m_x = 0;
+        int m_y = 0;
+        int m_key = 0;
+        bool m_shiftKey = false;
+        bool m_ctrlKey = false;
+    };
+
     /**
      * Parse JSON instructions for experimental editor functions.
      */
     ///@{
     bool Chain(jsonxx::Array actions);
+    bool Batch(jsonxx::Array actions);
+    bool ParseBatchAction(jsonxx::Object json, BatchAction &batchAction);
     bool ParseDeleteAction(jsonxx::Object param, std::string &elementId);
     bool ParseDragAction(jsonxx::Object param, std::string &elementId, int &x, int &y);
     bool ParseKeyDownAction(jsonxx::Object param, std::string &elementid, int &key, bool &shiftKey, bool &ctrlKey);
@@ -67,10 +90,73 @@ protected:
 
     Object *GetElement(std::string &elementId);
 
+    /**
+     * Get an element of the current drawing page.
+     * Within a batch, the elements resolved before applying it are used when possible.
+     */
+    Object *GetDrawingPageElement(const std::string &elementId);
+
+    /**
+     * @name Methods for applying a batch of actions as a single transaction
+     */
+    ///@{
+    /**
+     * Apply a parsed action of a batch.
+     */
+    bool ApplyBatchAction(BatchAction &batchAction);
+
+    /**
+     * Resolve all the ids of a batch before applying it, with a single lookup in the id index of the document.
+     * Return false if an element cannot be found.
+     */
+    bool ResolveBatchElements(const std::vector<BatchAction> &batchActions);
+
+    /**
+     * Get an element resolved for the batch, or look for it in the whole document and keep it.
+     */
+    Object *GetBatchElement(const std::string &elementId);
+
+    /**
+     * Look again for the elements resolved in a measure once its content was changed, since they might have been
+     * replaced or deleted. The element created by the action (the chained id) is resolved too.
+     */
+    void UpdateBatchElements(Object *measure);
+
+    /**
+     * Keep a copy of the measure of an element before it gets modified by a batch.
+     * For an element outside measures, the copy is the one of its scoreDef or of the element itself.
+     * Return false if no valid copy can be made.
+     */
+    bool KeepBatchCopy(Object *element);
+
+    /**
+     * Copy the ids, the comments and the links of an object and of its descendants to its copy.
+     * Return false if the copy does not have the same structure.
+     */
+    bool CopyIdentity(Object *source, Object *target);
+
+    /**
+     * Put back the copies of the content modified by the batch, or delete them if the batch is committed.
+     */
+    void EndBatch(bool rollback);
+    ///@}
+
+    /**
+     * Mark the measure of a modified element for the layout to be redone (see Toolkit::RedoEditedLayout).
+     * This includes the measure where time spanning elements end.
+     */
+    void SetMeasureDirty(Object *object);
+
 public:
     //
 protected:
     std::string m_chainedId;
+    /** True when a batch is applied */
+    bool m_isBatch;
+    /** The elements resolved for the batch, with their measure (NULL for elements outside measures) */
+    std::unordered_map<std::string, std::pair<Object *, Object *>> m_batchElements;
+    /** The copies of the content modified by the batch, with the objects they replace on rollback */
+    std::map<Object *, Object *> m_batchCopies;
 };
 } // namespace vrv
 
@@ -45,6 +45,11 @@ public:
      */
     void ToJson(std::string &output);
 
+    /**
+     * Fill a JSON object with the current content of the extractor, without serializing it
+     */
+    void ToJson(jsonxx::Object &o);
+
 private:
     //
 public:
@@ -10,6 +10,7 @@
 
 #include <list>
 #include <string>
+#include <string_view>
 #include <vector>
 
 //----------------------------------------------------------------------------
@@ -23,6 +24,69 @@ class zip_file;
 
 namespace vrv {
 
+//----------------------------------------------------------------------------
+// MemoryMappedFile
+//----------------------------------------------------------------------------
+
+/**
+ * This class gives a read-only view on the content of a file.
+ * The file is memory-mapped when the platform supports it and read into a buffer otherwise.
+ * The view remains valid until the file is closed.
+ */
+class MemoryMappedFile {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    MemoryMappedFile();
+    ~MemoryMappedFile();
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+    ///@}
+
+    /**
+     * Open the file and map its content.
+     */
+    bool Open(const std::string &filename);
+
+    /**
+     * Unmap the file and release the buffer.
+     */
+    void Close();
+
+    /**
+     * @name Getters for the content of the file
+     */
+    ///@{
+    bool IsOpen() const { return m_isOpen; }
+    std::string_view GetView() const { return std::string_view(m_data, m_size); }
+    const unsigned char *GetBytes() const { return reinterpret_cast<const unsigned char *>(m_data); }
+    size_t GetSize() const { return m_size; }
+    ///@}
+
+private:
+    /**
+     * Read the file into the fallback buffer.
+     */
+    bool ReadIntoBuffer(const std::string &filename);
+
+public:
+    //
+private:
+    /** The beginning of the content (mapped memory or fallback buffer) */
+    const char *m_data;
+    /** The size of the content */
+    size_t m_size;
+    /** A flag indicating that m_data is mapped and needs to be unmapped */
+    bool m_isMapped;
+    /** A flag indicating that the file was successfully opened */
+    bool m_isOpen;
+    /** The fallback buffer when the file cannot be mapped */
+    std::string m_buffer;
+
+}; // class MemoryMappedFile
+
 //----------------------------------------------------------------------------
 // ZipFileReader
 //----------------------------------------------------------------------------
@@ -55,6 +119,11 @@ public:
      */
     bool LoadBytes(const std::vector<unsigned char> &bytes);
 
+    /**
+     * Load a buffer of bytes into memory
+     */
+    bool LoadBuffer(const unsigned char *data, size_t length);
+
     /**
      * Check if the archive contains the file
      */
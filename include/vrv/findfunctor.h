@@ -251,6 +251,50 @@ private:
     const Object *m_element;
 };
 
+//----------------------------------------------------------------------------
+// IndexByIDFunctor
+//----------------------------------------------------------------------------
+
+/**
+ * This class fills a map of ids to elements.
+ * Ids appearing more than once in the tree, or elements reached through a reference object, are mapped to NULL.
+ */
+class IndexByIDFunctor : public ConstFunctor {
+public:
+    /**
+     * @name Constructors, destructors
+     */
+    ///@{
+    IndexByIDFunctor(MapOfStrConstObjects *index, const Object *root);
+    virtual ~IndexByIDFunctor() = default;
+    ///@}
+
+    /*
+     * Abstract base implementation
+     */
+    bool ImplementsEndInterface() const override { return true; }
+
+    /*
+     * Functor interface
+     */
+    ///@{
+    FunctorCode VisitObject(const Object *object) override;
+    FunctorCode VisitObjectEnd(const Object *object) override;
+    ///@}
+
+protected:
+    //
+private:
+    //
+public:
+    //
+private:
+    // The index being filled
+    MapOfStrConstObjects *m_index;
+    // The objects currently being visited
+    std::vector<const Object *> m_ancestors;
+};
+
 //----------------------------------------------------------------------------
 // FindNextChildByComparisonFunctor
 //----------------------------------------------------------------------------
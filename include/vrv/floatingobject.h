@@ -248,6 +248,12 @@ public:
      */
     int GetAdmissibleHorizOverlapMargin(const BoundingBox *bbox, int unit) const;
 
+    /**
+     * Return the horizontal range a bounding box has to overlap for HasHorizontalOverlapWith to be true.
+     * The range takes the largest admissible margin into account and is used for querying a BoundingBoxIndex.
+     */
+    std::pair<int, int> GetHorizontalOverlapRange(int unit) const;
+
     /**
      * Update the Y drawing relative position based on collision detection with the overlapping bounding box
      */
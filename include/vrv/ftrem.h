@@ -36,6 +36,11 @@ public:
     std::string GetClassName() const override { return "FTrem"; }
     ///@}
 
+    /**
+     * Overriding CloneReset() method to be called after copy / assignment calls.
+     */
+    void CloneReset() override;
+
     /**
      * @name Getter to interfaces
      */
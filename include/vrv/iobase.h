@@ -9,6 +9,7 @@
 #define __VRV_IOBASE_H__
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 //----------------------------------------------------------------------------
@@ -72,6 +73,13 @@ public:
     // read
     virtual bool Import(std::string const &data) { return true; }
 
+    /**
+     * Import from a read-only view on the data (e.g., a memory-mapped file).
+     * The default implementation copies the data and calls Import.
+     * Input classes that can parse the data in place should override it.
+     */
+    virtual bool ImportBuffer(std::string_view data) { return this->Import(std::string(data)); }
+
     /**
      * Getter for layoutInformation flag that is set to true during import
      * if layout information is found (and not to be ignored).
@@ -612,6 +612,7 @@ public:
     virtual ~MEIInput();
 
     bool Import(const std::string &mei) override;
+    bool ImportBuffer(std::string_view mei) override;
 
 private:
     bool ReadDoc(pugi::xml_node root);
@@ -206,6 +206,7 @@ private:
 #ifndef NO_MUSICXML_SUPPORT
 public:
     bool Import(const std::string &musicxml) override;
+    bool ImportBuffer(std::string_view musicxml) override;
 
 private:
     /*
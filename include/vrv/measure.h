@@ -127,9 +127,19 @@ public:
     void SetDrawingXRel(int drawingXRel);
     void CacheXRel(bool restore = false);
     int GetCachedXRel() const { return m_cachedXRel; }
+    void SetCachedXRel(int cachedXRel) { m_cachedXRel = cachedXRel; }
     void ResetCachedXRel() { m_cachedXRel = VRV_UNSET; }
     ///@}
 
+    /**
+     * @name Set and get the flag indicating that the content of the measure was modified by the editor
+     * and that its horizontal layout has to be redone (see Doc::LayOutDirtyMeasures)
+     */
+    ///@{
+    void SetDirty(bool isDirty) { m_isDirty = isDirty; }
+    bool IsDirty() const { return m_isDirty; }
+    ///@}
+
     /**
      * @name Check if the measure is the first or last in the system
      */
@@ -241,10 +251,18 @@ public:
     ///@{
     int GetCachedWidth() const { return m_cachedWidth; }
     int GetCachedOverflow() const { return m_cachedOverflow; }
+    int GetCachedJustifiableWidth() const { return m_cachedJustifiableWidth; }
     void ResetCachedWidth() { m_cachedWidth = VRV_UNSET; }
     void ResetCachedOverflow() { m_cachedOverflow = VRV_UNSET; }
     ///@}
 
+    /**
+     * Update the cached width and overflow once the measure has been laid out again in its cast-off system.
+     * The width of the measure in the system includes the system scoreDef or cautionary signatures, so the cached
+     * width is changed by the difference of the justifiable width only. Return the difference.
+     */
+    int UpdateCachedWidth();
+
     /**
      * Return the right overflow of the control events in the measure.
      * Takes into account Dir, Dynam, and Tempo.
@@ -405,8 +423,14 @@ protected:
     ///@{
     int m_cachedOverflow;
     int m_cachedWidth;
+    int m_cachedJustifiableWidth;
     ///@}
 
+    /**
+     * A flag indicating that the measure was modified since its horizontal layout was cached
+     */
+    bool m_isDirty;
+
 private:
     /**
      * Indicate measured music (CMN), unmeasured (fake measures for mensural or neumes) or neume lines
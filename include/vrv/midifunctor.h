@@ -260,8 +260,28 @@ struct MIDIChord {
 
 using MIDIChordSequence = std::list<MIDIChord>;
 
+/**
+ * Helper struct for the generation state of a staff/layer pair exported to a MIDI track
+ */
+struct MIDILayer {
+    int m_staffN = 0;
+    int m_layerN = 0;
+    int m_midiTrack = 1;
+    int m_midiChannel = 0;
+    int m_transSemi = 0;
+    // The temporary track collecting the events of the layer during the traversal
+    int m_eventTrack = 0;
+    const Note *m_lastNote = NULL;
+    MIDIChordSequence m_graceNotes;
+    bool m_accentedGraceNote = false;
+};
+
 /**
  * This class performs the export to a MidiFile.
+ * All the staff/layer pairs added with AddLayer are exported in a single traversal of the document. The events of
+ * each layer are collected in a temporary track and appended to the MIDI track of the layer in VisitDocEnd, in the
+ * order in which the layers were added.
+ * Without any layer added, the events are written to the track set with SetTrack, e.g., for processing a scoreDef.
  */
 class GenerateMIDIFunctor : public ConstFunctor {
 public:
@@ -286,11 +306,14 @@ public:
     void SetCueExclusion(bool cueExclusion) { m_cueExclusion = cueExclusion; }
     void SetCurrentTempo(double tempo) { m_currentTempo = tempo; }
     void SetDeferredNotes(const std::map<const Note *, double> &deferredNotes) { m_deferredNotes = deferredNotes; }
-    void SetStaffN(int staffN) { m_staffN = staffN; }
     void SetTrack(int track) { m_midiTrack = track; }
-    void SetTransSemi(int transSemi) { m_transSemi = transSemi; }
     ///@}
 
+    /**
+     * Add a staff/layer pair to be exported to a MIDI track and channel
+     */
+    void AddLayer(int staffN, int layerN, int track, int channel, int transSemi);
+
     /*
      * Functor interface
      */
@@ -298,6 +321,8 @@ public:
     FunctorCode VisitBeatRpt(const BeatRpt *beatRpt) override;
     FunctorCode VisitBTrem(const BTrem *bTrem) override;
     FunctorCode VisitChord(const Chord *chord) override;
+    FunctorCode VisitDoc(const Doc *doc) override;
+    FunctorCode VisitDocEnd(const Doc *doc) override;
     FunctorCode VisitFTrem(const FTrem *fTrem) override;
     FunctorCode VisitGraceGrpEnd(const GraceGrp *graceGrp) override;
     FunctorCode VisitHalfmRpt(const HalfmRpt *halfmRpt) override;
@@ -328,6 +353,14 @@ private:
      */
     void GenerateGraceNoteMIDI(const Note *refNote, double startTime, int tpq, int channel, int velocity);
 
+    /**
+     * Create the MIDI output of a pedal or of a scoreDef for a track and channel
+     */
+    ///@{
+    void GeneratePedalMIDI(const Pedal *pedal, int track, int channel);
+    void GenerateScoreDefMIDI(const ScoreDef *scoreDef, int track);
+    ///@}
+
 public:
     //
 private:
@@ -359,6 +392,9 @@ private:
     bool m_cueExclusion;
     // Tablature held notes indexed by (course - 1)
     std::vector<MIDIHeldNote> m_heldNotes;
+    // The staff/layer pairs to export and the one currently processed (-1 if none)
+    std::vector<MIDILayer> m_layers;
+    int m_currentLayer;
 };
 
 //----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #ifndef __VRV_OBJECT_H__
 #define __VRV_OBJECT_H__
 
+#include <atomic>
 #include <cstdlib>
 #include <functional>
 #include <iterator>
@@ -48,6 +49,7 @@ class Zone;
 #define UNLIMITED_DEPTH -10000
 #define FORWARD true
 #define BACKWARD false
+#define MAX_FUSED_FUNCTORS 32
 
 //----------------------------------------------------------------------------
 // Object
@@ -71,6 +73,15 @@ public:
     virtual std::string GetClassName() const { return "[MISSING]"; }
     ///@}
 
+    /**
+     * Objects are allocated in the ObjectArena current for the thread, or on the heap when none is set.
+     * See Doc::GetObjectArena and ObjectArenaScope
+     */
+    ///@{
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr);
+    ///@}
+
     /**
      * Make an object a reference object that do not own children.
      * This cannot be un-done and has to be set before any child is added.
@@ -242,7 +253,11 @@ public:
     virtual void CloneReset();
 
     const std::string &GetID() const { return m_id; }
-    void SetID(const std::string &id) { m_id = id; }
+    void SetID(const std::string &id)
+    {
+        m_id = id;
+        IncrementTreeRevision();
+    }
     void SwapID(Object *other);
     void ResetID();
 
@@ -290,7 +305,11 @@ public:
      * Return a reference to the children that allows modification.
      * This method should be all only in AddChild overrides methods
      */
-    ArrayOfObjects &GetChildrenForModification() { return m_children; }
+    ArrayOfObjects &GetChildrenForModification()
+    {
+        IncrementTreeRevision();
+        return m_children;
+    }
 
     /**
      * Fill an array of pairs with all attributes and their values.
@@ -354,7 +373,11 @@ public:
      * Reset the parent of the Object.
      * The current parent is not expected to be NULL.
      */
-    void ResetParent() { m_parent = NULL; }
+    void ResetParent()
+    {
+        m_parent = NULL;
+        IncrementTreeRevision();
+    }
 
     /**
      * Base method for checking if a child can be added.
@@ -628,6 +651,7 @@ public:
     template <class Compare> void StableSort(Compare comp)
     {
         std::stable_sort(m_children.begin(), m_children.end(), comp);
+        IncrementTreeRevision();
     }
 
     void ReorderByXPos();
@@ -649,6 +673,17 @@ public:
     void Process(ConstFunctor &functor, int deepness = UNLIMITED_DEPTH, bool skipFirst = false) const;
     ///@}
 
+    /**
+     * Process several functors in a single traversal of the tree.
+     * For each object, the functors are called in the order of the vector, and so are the end methods after the
+     * children. Each functor keeps its own return code, meaning that FUNCTOR_SIBLINGS or FUNCTOR_STOP returned by
+     * one functor does not change the traversal of the other ones. A functor can therefore only be fused with the
+     * ones before it when it does not depend on what they do on objects coming later in the tree.
+     * All the functors must process forward, without filters, and with the same visibility.
+     * At most MAX_FUSED_FUNCTORS functors can be processed together.
+     */
+    void Process(const std::vector<Functor *> &functors, int deepness = UNLIMITED_DEPTH);
+
     /**
      * Interface for class functor visitation
      */
@@ -679,6 +714,13 @@ public:
 
     static bool sortByUlx(Object *a, Object *b);
 
+    /**
+     * Return the current revision of the object trees.
+     * The revision is increased every time an object is added, removed, moved or has its id changed.
+     * It is used for checking if an id index built on a tree (see Doc::FindByID) is still valid.
+     */
+    static uint64_t GetTreeRevision() { return s_treeRevision.load(std::memory_order_relaxed); }
+
     /**
      * Return true if left appears before right in preorder traversal
      */
@@ -695,12 +737,18 @@ private:
      */
     void Init(ClassId classId, const std::string &classIdStr);
 
+    /**
+     * Increase the tree revision - to be called for every structural change
+     */
+    static void IncrementTreeRevision() { s_treeRevision.fetch_add(1, std::memory_order_relaxed); }
+
     /**
      * Helper methods for functor processing
      */
     ///@{
     bool SkipChildren(bool visibleOnly) const;
     bool FiltersApply(const Filters *filters, Object *object) const;
+    void ProcessFused(const std::vector<Functor *> &functors, uint32_t active, int deepness);
     ///@}
 
 public:
@@ -804,6 +852,12 @@ private:
      * XML id counter
      */
     static thread_local uint32_t s_xmlIDCounter;
+
+    /**
+     * A static counter for tracking structural changes in all object trees.
+     * It is not thread local because a tree might be modified and queried from different threads.
+     */
+    static std::atomic<uint64_t> s_treeRevision;
 };
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,157 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        objectarena.h
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_OBJECTARENA_H__
+#define __VRV_OBJECTARENA_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace vrv {
+
+/** The size of the chunks allocated by the arena */
+#define ARENA_CHUNK_SIZE (256 * 1024)
+/** The size step between two size classes */
+#define ARENA_SIZE_STEP 64
+/** Objects larger than this are allocated on the heap */
+#define ARENA_MAX_SIZE 4096
+
+//----------------------------------------------------------------------------
+// ObjectArena
+//----------------------------------------------------------------------------
+
+/**
+ * This class is a pool allocator for the objects of a Doc.
+ * The memory is taken from large chunks and objects are grouped by size classes of ARENA_SIZE_STEP bytes.
+ * When an object is deleted, its memory is put back in the free list of its size class and is reused.
+ * The chunks are released in bulk when the arena is destroyed, or before when no object is alive anymore.
+ *
+ * Objects are allocated in the arena made current for the thread with ObjectArenaScope.
+ * Every allocation is preceded by a header pointing to its arena (or NULL when allocated on the heap),
+ * so objects can be deleted at any time and from any thread.
+ * The arena is kept alive as long as some of its objects are, even when its owner releases it.
+ */
+class ObjectArena {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    ObjectArena();
+    ObjectArena(const ObjectArena &) = delete;
+    ObjectArena &operator=(const ObjectArena &) = delete;
+    ///@}
+
+    /**
+     * Release the arena by its owner.
+     * It is deleted immediately if no object is alive, or otherwise when the last one is deleted.
+     */
+    void Release();
+
+    /**
+     * Release all the chunks at once if no object is alive.
+     */
+    void ReleaseChunks();
+
+    /**
+     * Allocate and deallocate memory for an object (see Object::operator new and delete).
+     * Objects are allocated in the current arena, or on the heap if there is none or if they are too large.
+     */
+    ///@{
+    static void *Allocate(std::size_t size);
+    static void Deallocate(void *ptr);
+    ///@}
+
+    /**
+     * Getter and setter for the arena of the current thread
+     */
+    ///@{
+    static ObjectArena *GetCurrent() { return s_current; }
+    static void SetCurrent(ObjectArena *arena) { s_current = arena; }
+    ///@}
+
+    /**
+     * @name Statistics
+     */
+    ///@{
+    int GetLiveCount() const { return m_liveCount; }
+    uint64_t GetAllocationCount() const { return m_allocationCount; }
+    uint64_t GetReuseCount() const { return m_reuseCount; }
+    size_t GetChunkCount() const { return m_chunks.size(); }
+    ///@}
+
+private:
+    /**
+     * The arena is deleted through Release.
+     */
+    ~ObjectArena();
+
+    /**
+     * Allocate and deallocate a block for a size class, including the header.
+     * DeallocateBlock returns true when the arena has been released and has to be deleted.
+     */
+    ///@{
+    void *AllocateBlock(int sizeClass);
+    bool DeallocateBlock(void *block, int sizeClass);
+    ///@}
+
+    void ClearChunks();
+
+public:
+    //
+private:
+    /** The arena of the current thread */
+    static thread_local ObjectArena *s_current;
+
+    /** Protects the chunks and the free lists since objects can be deleted in another thread */
+    std::mutex m_mutex;
+    /** The chunks allocated and the position in the current one */
+    std::vector<char *> m_chunks;
+    size_t m_currentChunk;
+    size_t m_chunkOffset;
+    /** The free lists by size class, linked through the first bytes of the blocks */
+    std::vector<void *> m_freeLists;
+    /** The number of objects currently allocated */
+    int m_liveCount;
+    /** True once released by its owner */
+    bool m_released;
+    /** Statistics */
+    uint64_t m_allocationCount;
+    uint64_t m_reuseCount;
+};
+
+//----------------------------------------------------------------------------
+// ObjectArenaScope
+//----------------------------------------------------------------------------
+
+/**
+ * This class makes an arena current for the thread for the lifetime of the object.
+ * The previous one is restored at the end. A NULL arena allocates on the heap.
+ */
+class ObjectArenaScope {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    ObjectArenaScope(ObjectArena *arena);
+    ~ObjectArenaScope();
+    ///@}
+
+private:
+    //
+public:
+    //
+private:
+    ObjectArena *m_previous;
+};
+
+} // namespace vrv
+
+#endif // __VRV_OBJECTARENA_H__
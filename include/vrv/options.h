@@ -56,6 +56,8 @@ class OptionGrp;
 // Option defines
 //----------------------------------------------------------------------------
 
+enum option_BOUNDINGBOXES { BOUNDINGBOXES_draw = 0, BOUNDINGBOXES_metrics, BOUNDINGBOXES_check };
+
 enum option_BREAKS { BREAKS_none = 0, BREAKS_auto, BREAKS_line, BREAKS_smart, BREAKS_encoded };
 
 enum option_CONDENSE { CONDENSE_none = 0, CONDENSE_auto, CONDENSE_all, CONDENSE_encoded };
@@ -139,6 +141,7 @@ public:
     /**
      * Static maps used my OptionIntMap objects. Set in OptIntMap::Init
      */
+    static const std::map<int, std::string> s_boundingBoxes;
     static const std::map<int, std::string> s_breaks;
     static const std::map<int, std::string> s_condense;
     static const std::map<int, std::string> s_elision;
@@ -602,6 +605,7 @@ public:
     OptionString m_help;
     OptionBool m_allPages;
     OptionString m_inputFrom;
+    OptionInt m_threads;
     OptionString m_logLevel;
     OptionString m_outfile;
     OptionInt m_page;
@@ -618,8 +622,10 @@ public:
 
     OptionBool m_adjustPageHeight;
     OptionBool m_adjustPageWidth;
+    OptionIntMap m_boundingBoxes;
     OptionIntMap m_breaks;
     OptionDbl m_breaksSmartSb;
+    OptionBool m_breaksEstimateHeight;
     OptionIntMap m_condense;
     OptionBool m_condenseFirstPage;
     OptionBool m_condenseNotLastSystem;
@@ -650,6 +656,7 @@ public:
     OptionInt m_pageWidth;
     OptionIntMap m_pedalStyle;
     OptionBool m_preserveAnalyticalMarkup;
+    OptionString m_profileTrace;
     OptionBool m_removeIds;
     OptionBool m_scaleToPageSize;
     OptionBool m_setLocale;
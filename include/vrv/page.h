@@ -115,6 +115,13 @@ public:
      */
     void LayOutVertically();
 
+    /**
+     * Estimate the vertical layout of the content of the page (system/staves) without drawing it.
+     * Only the position of the notes, rests and stems is taken into account and floating elements are estimated.
+     * This is used for breaking the pages of large documents quickly (see Options::m_breaksEstimateHeight).
+     */
+    void EstimateVerticalLayout();
+
     /**
      * Justifiy the content of the page (system/staves) vertically
      */
@@ -145,6 +152,12 @@ public:
      */
     int GetContentWidth() const;
 
+    /**
+     * Find the objects with a self bounding box enclosing a point (in logical coordinates) in the systems of the page.
+     * The page has to be laid out. The objects of each system are returned from the smallest bounding box.
+     */
+    void FindAllAtPoint(int x, int y, ListOfObjects &objects);
+
     //----------//
     // Functors //
     //----------//
@@ -170,6 +183,11 @@ private:
      */
     bool IsJustificationRequired(const Doc *doc);
 
+    /**
+     * Reset the spatial indexes of the systems since their bounding boxes are laid out again
+     */
+    void ResetDrawingBBoxIndexes();
+
     //
 public:
     /** Page width (MEI scoredef@page.width). Saved if != -1 */
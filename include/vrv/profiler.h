@@ -0,0 +1,245 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        profiler.h
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_PROFILER_H__
+#define __VRV_PROFILER_H__
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "vrvdef.h"
+
+namespace vrv {
+
+class Functor;
+class FunctorBase;
+class Object;
+
+//----------------------------------------------------------------------------
+// ProfilerEntry
+//----------------------------------------------------------------------------
+
+/**
+ * This class holds what the profiler records for a functor or for a processing step.
+ */
+class ProfilerEntry {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    ProfilerEntry();
+    virtual ~ProfilerEntry() = default;
+    ///@}
+
+private:
+    //
+public:
+    /** The name of the functor or of the processing step */
+    std::string m_name;
+    /** The number of traversals or calls */
+    int m_calls;
+    /** The number of traversals shared with other functors (see Object::Process) */
+    int m_fusedCalls;
+    /** The wall time in milliseconds */
+    double m_time;
+    /** The number of objects visited, in total and by ClassId */
+    ///@{
+    uint64_t m_visits;
+    std::vector<uint64_t> m_classVisits;
+    ///@}
+
+private:
+    //
+};
+
+//----------------------------------------------------------------------------
+// Profiler
+//----------------------------------------------------------------------------
+
+/**
+ * This class records the time spent in the functors processed with Object::Process and in the Doc processing steps.
+ * For each functor, it also counts the objects visited, in total and by ClassId.
+ * The profiler records only for the thread in which it was made active.
+ * When no profiler is active, Object::Process does not do anything else than checking it.
+ */
+class Profiler {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    Profiler();
+    virtual ~Profiler() = default;
+    ///@}
+
+    /**
+     * Clear everything that was recorded.
+     */
+    void Reset();
+
+    /**
+     * Getter and setter for the profiler recording for the current thread.
+     * NULL when profiling is disabled.
+     */
+    ///@{
+    static Profiler *GetActive() { return s_active; }
+    static void SetActive(Profiler *profiler) { s_active = profiler; }
+    ///@}
+
+    /**
+     * Return true if the functor is processed in the current scope.
+     * This is the case for the recursive calls of Object::Process.
+     */
+    bool IsProcessing(const FunctorBase *functor) const;
+
+    /**
+     * Start a scope for the traversal of one functor or of several functors processed together.
+     * The scope has to be closed with EndScope.
+     */
+    ///@{
+    void StartFunctor(const FunctorBase *functor);
+    void StartFunctors(const std::vector<Functor *> &functors);
+    ///@}
+
+    /**
+     * Start a scope for a processing step.
+     * The scope has to be closed with EndScope.
+     */
+    void StartStep(const std::string &name);
+
+    /**
+     * Close the current scope.
+     */
+    void EndScope();
+
+    /**
+     * Add a processing step that has already been completed.
+     */
+    void AddStep(const std::string &name, std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point end);
+
+    /**
+     * Count the visit of an object by a functor processed in the current scope.
+     */
+    void AddVisit(const FunctorBase *functor, const Object *object);
+
+    /**
+     * Return the entries sorted by decreasing time.
+     */
+    ///@{
+    std::vector<const ProfilerEntry *> GetFunctorEntries() const;
+    std::vector<const ProfilerEntry *> GetStepEntries() const;
+    ///@}
+
+    /**
+     * Return the class name for a ClassId visited.
+     */
+    std::string GetClassName(ClassId classId) const;
+
+    /**
+     * Return a JSON string with the functor and step entries.
+     */
+    std::string GetProfileJSON() const;
+
+    /**
+     * Return a JSON string in the trace event format (chrome://tracing or https://ui.perfetto.dev).
+     */
+    std::string GetTraceJSON() const;
+
+private:
+    /**
+     * Return the entry for the functor, creating it if necessary.
+     */
+    ProfilerEntry *GetFunctorEntry(const FunctorBase *functor);
+
+    /**
+     * Return the class name of a functor or an object without the namespace.
+     */
+    static std::string GetTypeName(const std::type_info &typeInfo);
+
+    /**
+     * Time elapsed since the profiler was reset, in microseconds.
+     */
+    double GetTimestamp(std::chrono::steady_clock::time_point timePoint) const;
+
+public:
+    //
+private:
+    /**
+     * A scope currently opened.
+     * Functors are paired with their entries, and the step entry is NULL for functor scopes.
+     */
+    struct Scope {
+        std::vector<std::pair<const FunctorBase *, ProfilerEntry *>> m_functors;
+        ProfilerEntry *m_step;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    /**
+     * A completed scope for the trace events.
+     * Start and duration are in microseconds.
+     */
+    struct Event {
+        std::string m_name;
+        bool m_isStep;
+        double m_start;
+        double m_duration;
+    };
+
+    /** The profiler active in the current thread */
+    static thread_local Profiler *s_active;
+
+    /** The time point from which the events are timed */
+    std::chrono::steady_clock::time_point m_origin;
+    /** The entries of the functors by type and of the steps by name */
+    std::map<std::type_index, ProfilerEntry> m_functorEntries;
+    std::map<std::string, ProfilerEntry> m_stepEntries;
+    /** The class names of the ClassId visited */
+    std::vector<std::string> m_classNames;
+    /** The stack of scopes currently opened */
+    std::vector<Scope> m_scopes;
+    /** The trace events */
+    std::vector<Event> m_events;
+};
+
+//----------------------------------------------------------------------------
+// ProfilerStep
+//----------------------------------------------------------------------------
+
+/**
+ * This class profiles a processing step for the lifetime of the object.
+ * It does nothing when no profiler is active.
+ */
+class ProfilerStep {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    ProfilerStep(const char *name);
+    ~ProfilerStep();
+    ///@}
+
+private:
+    //
+public:
+    //
+private:
+    /** The profiler when one was active at the creation */
+    Profiler *m_profiler;
+};
+
+} // namespace vrv
+
+#endif // __VRV_PROFILER_H__
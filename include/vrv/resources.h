@@ -8,6 +8,7 @@
 #ifndef __VRV_RESOURCES_H__
 #define __VRV_RESOURCES_H__
 
+#include <cstdint>
 #include <unordered_map>
 
 //----------------------------------------------------------------------------
@@ -156,6 +157,73 @@ private:
         std::string m_css;
     };
 
+    //----------------------------------------------------------------------------
+    // BinaryGlyphTable
+    //----------------------------------------------------------------------------
+
+    /**
+     * A read-only view on a binary glyph table generated by fonts/generate_binary.py.
+     * The file is memory-mapped and the records are read in place.
+     * See the generator script for the description of the format.
+     */
+    class BinaryGlyphTable {
+
+    public:
+        BinaryGlyphTable();
+
+        struct Header {
+            char m_magic[4];
+            uint32_t m_version;
+            uint32_t m_sourceSize;
+            int32_t m_unitsPerEm;
+            uint32_t m_glyphCount;
+            uint32_t m_anchorCount;
+            uint32_t m_stringsSize;
+            uint32_t m_reserved;
+        };
+
+        struct GlyphRecord {
+            uint32_t m_code;
+            uint32_t m_codeStr;
+            uint32_t m_name;
+            uint32_t m_firstAnchor;
+            uint32_t m_anchorCount;
+            float m_x;
+            float m_y;
+            float m_width;
+            float m_height;
+            float m_horizAdvX;
+        };
+
+        struct AnchorRecord {
+            uint32_t m_name;
+            float m_x;
+            float m_y;
+        };
+
+        /**
+         * Open the binary file for the XML file (basename without extension).
+         * Return false if the file is missing, invalid, or does not match the XML file.
+         */
+        bool Open(const std::string &basename);
+
+        int GetUnitsPerEm() const { return m_header.m_unitsPerEm; }
+        uint32_t GetGlyphCount() const { return m_header.m_glyphCount; }
+        GlyphRecord GetGlyph(uint32_t idx) const;
+        AnchorRecord GetAnchor(uint32_t idx) const;
+        /** Return the string at the offset, or NULL for a missing string */
+        const char *GetString(uint32_t offset) const;
+
+    private:
+        bool IsValid() const;
+
+        MemoryMappedFile m_file;
+        Header m_header;
+        const char *m_glyphs;
+        const char *m_anchors;
+        const char *m_strings;
+    };
+
     //----------------------------------------------------------------------------
 
     bool LoadFont(const std::string &fontName, ZipFileReader *zipFile = NULL);
@@ -171,7 +239,6 @@ private:
 
     /** A text font used for bounding box calculations */
     GlyphTextMap m_textFont;
-    mutable StyleAttributes m_currentStyle;
     /**
      * A map of glyph name / code
      */
@@ -184,6 +251,9 @@ private:
     /** The default path to the resources directory (e.g., for the svg/ subdirectory with fonts as XML */
     static thread_local std::string s_defaultPath;
 
+    /** The current text font style - thread local since pages can be drawn concurrently */
+    static thread_local StyleAttributes s_currentStyle;
+
     /** The default font style */
     static const StyleAttributes k_defaultStyle;
 };
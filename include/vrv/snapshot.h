@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        snapshot.h
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_SNAPSHOT_H__
+#define __VRV_SNAPSHOT_H__
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "doc.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// Snapshot
+//----------------------------------------------------------------------------
+
+/**
+ * This class reads and writes snapshots of a loaded document.
+ * A snapshot contains the score-based MEI of the document together with its cast-off layout (see
+ * Doc::GetCastOffLayout), so it can be loaded again without casting off the document.
+ * The signature identifies the version and the options it was written with. The layout is used only when it matches.
+ *
+ * The format is little-endian: a 32-byte header, the signature, the layout records and the MEI.
+ * The records are read in place from the data given to Read, which has to remain valid.
+ */
+class Snapshot {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    Snapshot();
+    virtual ~Snapshot() = default;
+    ///@}
+
+    struct Header {
+        char m_magic[4];
+        uint32_t m_version;
+        uint32_t m_signatureSize;
+        uint32_t m_recordCount;
+        uint64_t m_meiSize;
+        uint32_t m_reserved[2];
+    };
+
+    /**
+     * Return true if the data starts like a snapshot.
+     */
+    static bool IsSnapshot(std::string_view data);
+
+    /**
+     * Read the snapshot from the data.
+     * Return false if the data is not a valid snapshot.
+     */
+    bool Read(std::string_view data);
+
+    /**
+     * Write a snapshot to a file.
+     */
+    static bool Write(const std::string &filename, const std::string &signature,
+        const std::vector<CastOffRecord> &layout, const std::string &mei);
+
+    /**
+     * @name Getters for the content of the snapshot read
+     */
+    ///@{
+    std::string_view GetSignature() const { return m_signature; }
+    std::string_view GetMEI() const { return m_mei; }
+    void GetLayout(std::vector<CastOffRecord> &layout) const;
+    ///@}
+
+private:
+    //
+public:
+    //
+private:
+    Header m_header;
+    std::string_view m_signature;
+    const char *m_records;
+    std::string_view m_mei;
+};
+
+} // namespace vrv
+
+#endif // __VRV_SNAPSHOT_H__
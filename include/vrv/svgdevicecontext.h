@@ -12,6 +12,7 @@
 #include <list>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 //----------------------------------------------------------------------------
@@ -293,6 +294,15 @@ private:
 
     pugi::xml_node AddChild(std::string name);
 
+    /**
+     * Keep track of the <g> elements with an id for ResumeGraphic.
+     * The second method also indexes the <g> elements of a copied subtree.
+     */
+    ///@{
+    void IndexGraphic(pugi::xml_node node, const std::string &gId);
+    void IndexGraphicSubtree(pugi::xml_node node);
+    ///@}
+
     /**
      * Transform pen properties into stroke attributes
      */
@@ -317,11 +327,23 @@ private:
      */
     bool m_vrvTextFontFallback;
 
-    // we use a std::stringstream because we want to prepend the <defs> which will know only when we reach the end of
-    // the page
+    // we build a pugixml document because we want to prepend the <defs> which will know only when we reach the end of
+    // the page, and because graphics can be resumed (ResumeGraphic) after they have been ended
     // some viewer seem to support to have the <defs> at the end, but some do not (pdf2svg, for example)
-    // for this reason, the full svg is finally written a string from the destructor or when Flush() is called
-    std::ostringstream m_outdata;
+    // for this reason, the full svg is finally written to the string in Commit()
+    std::string m_outdata;
+
+    /**
+     * A pugixml writer appending to a string
+     */
+    class StringWriter : public pugi::xml_writer {
+    public:
+        StringWriter(std::string &output) : m_output(output) {}
+        void write(const void *data, size_t size) override { m_output.append(static_cast<const char *>(data), size); }
+
+    private:
+        std::string &m_output;
+    };
 
     bool m_committed; // did we flushed the file?
     int m_originX, m_originY;
@@ -355,6 +377,9 @@ private:
     pugi::xml_node m_pageNode;
     pugi::xml_node m_currentNode;
     std::list<pugi::xml_node> m_svgNodeStack;
+    // the <g> elements by id (or data-id with html5) for ResumeGraphic
+    // ids used more than once are mapped to an empty node and are looked up with XPath
+    std::unordered_map<std::string, pugi::xml_node> m_graphicNodes;
 
     // output as mm (for pdf generation with a 72 dpi)
     bool m_mmOutput;
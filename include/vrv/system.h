@@ -97,6 +97,11 @@ public:
      */
     int GetSystemIdx() const { return Object::GetIdx(); }
 
+    /**
+     * Return true if one of the measures of the system was modified by the editor (see Measure::SetDirty)
+     */
+    bool HasDirtyMeasures() const;
+
     bool SetCurrentFloatingPositioner(
         int staffN, FloatingObject *object, Object *objectX, Object *objectY, char spanningType = SPANNING_START_END);
 
@@ -154,6 +159,14 @@ public:
      */
     double EstimateJustificationRatio(const Doc *doc) const;
 
+    /**
+     * Find the objects with a self bounding box enclosing a point (in logical coordinates).
+     * Floating objects are found with their positioners in the system.
+     * The bounding boxes are indexed when first needed and the index is reset when the page is laid out again.
+     */
+    void FindAllAtPoint(int x, int y, ListOfObjects &objects);
+    void ResetDrawingBBoxIndex() { m_drawingBBoxIndex.Clear(); }
+
     /**
      * Convert mensural MEI into cast-off (measure) segments looking at the barLine objects.
      * Segment positions occur where a barLine is set on all staves.
@@ -243,6 +256,11 @@ private:
      * This does not mean that a staff is hidden, but only that it can be optimized.
      */
     bool m_drawingIsOptimized;
+
+    /**
+     * The spatial index of the bounding boxes of the system for finding objects at a point
+     */
+    BoundingBoxIndex m_drawingBBoxIndex;
 };
 
 } // namespace vrv
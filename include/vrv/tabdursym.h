@@ -30,6 +30,7 @@ public:
     ///@{
     TabDurSym();
     virtual ~TabDurSym();
+    Object *Clone() const override { return new TabDurSym(*this); }
     void Reset() override;
     std::string GetClassName() const override { return "TabDurSym"; }
     ///@}
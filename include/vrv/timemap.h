@@ -15,6 +15,10 @@
 
 //----------------------------------------------------------------------------
 
+namespace jsonxx {
+class Array;
+} // namespace jsonxx
+
 namespace vrv {
 
 class Object;
@@ -66,6 +70,11 @@ public:
      */
     void ToJson(std::string &output, bool includetRests, bool includetMeasures);
 
+    /**
+     * Fill a JSON array with the current timemap, without serializing it
+     */
+    void ToJson(jsonxx::Array &timemap, bool includetRests, bool includetMeasures);
+
 private:
     //
 public:
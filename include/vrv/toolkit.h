@@ -9,6 +9,7 @@
 #define __VRV_TOOLKIT_H__
 
 #include <string>
+#include <string_view>
 
 //----------------------------------------------------------------------------
 
@@ -19,10 +20,17 @@
 
 //----------------------------------------------------------------------------
 
+namespace jsonxx {
+class Array;
+class Object;
+} // namespace jsonxx
+
 namespace vrv {
 
 class EditorToolkit;
+class Profiler;
 class RuntimeClock;
+class SvgDeviceContext;
 
 /**
  * @defgroup nodoc Public methods that are not listed in the documentation
@@ -113,6 +121,39 @@ public:
      */
     void ResetXmlIdSeed(int seed);
 
+    /**
+     * Start profiling the functors and the document processing steps.
+     *
+     * Anything recorded before is discarded. Only the calls made from the current thread are profiled.
+     */
+    void StartProfiling();
+
+    /**
+     * Stop profiling.
+     *
+     * The profile remains available until profiling is started again.
+     */
+    void StopProfiling();
+
+    /**
+     * Return the profile recorded as a JSON string.
+     *
+     * For each functor and document processing step, the profile gives the number of calls and the time in
+     * milliseconds. For each functor, it also gives the number of objects visited, in total and by class.
+     *
+     * @return A stringified JSON object with the functors and the steps sorted by decreasing time
+     */
+    std::string GetProfile() const;
+
+    /**
+     * Return the profile recorded in the trace event format.
+     *
+     * The trace can be loaded in chrome://tracing or https://ui.perfetto.dev.
+     *
+     * @return A stringified JSON object with the trace events
+     */
+    std::string GetProfileTrace() const;
+
     ///@}
 
     /**
@@ -357,6 +398,20 @@ public:
      */
     std::string RenderToSVG(int pageNo = 1, bool xmlDeclaration = false);
 
+    /**
+     * Render all the pages to SVG.
+     *
+     * The pages are laid out first and then drawn concurrently.
+     * The output is identical to calling RenderToSVG for each page.
+     *
+     * @remark nojs
+     *
+     * @param threads The number of threads to use (0 for the number of cores available)
+     * @param xmlDeclaration True for including the xml declaration in the SVG output
+     * @return The SVG pages as strings
+     */
+    std::vector<std::string> RenderAllToSVG(int threads = 0, bool xmlDeclaration = false);
+
     /**
      * Render a page to SVG and save it to the file.
      *
@@ -519,6 +574,19 @@ public:
      */
     bool SaveFile(const std::string &filename, const std::string &jsonOptions = "");
 
+    /**
+     * Save a snapshot of the loaded document to a file.
+     *
+     * The snapshot contains the MEI and the layout of the document. When loaded again with LoadFile
+     * and the same version and options, the layout is restored instead of being recalculated.
+     *
+     * @remark nojs
+     *
+     * @param filename The output filename
+     * @return True if the file was successfully written
+     */
+    bool SaveSnapshotFile(const std::string &filename);
+
     ///@}
 
     /**
@@ -546,6 +614,19 @@ public:
      */
     std::string GetElementsAtTime(int millisec);
 
+    /**
+     * Return array of IDs of elements rendered at a point of a page.
+     *
+     * The coordinates are the ones of the SVG page content (the page-margin group), with the y axis going down.
+     * Elements are found with their own bounding box, which does not include their children.
+     *
+     * @param pageNo The page number (1-based)
+     * @param x The x coordinate
+     * @param y The y coordinate
+     * @return A stringified JSON array of IDs, from the element with the smallest bounding box
+     */
+    std::string GetElementsAtPoint(int pageNo, int x, int y);
+
     /**
      * Return the page on which the element is the ID (\@xml:id) is rendered
      *
@@ -639,6 +720,17 @@ public:
      */
     void RedoPagePitchPosLayout();
 
+    /**
+     * Redo the layout of the loaded data after it was modified with Edit().
+     *
+     * Only the measures modified since the last layout are laid out again horizontally, and the layout of the other
+     * measures is restored from the cache before casting off the document again.
+     * Falls back to RedoLayout() when no cached layout is available.
+     *
+     * @return A stringified JSON array with the numbers of the pages that need to be rendered again
+     */
+    std::string RedoEditedLayout();
+
     ///@}
 
     //------------------------------------------------//
@@ -668,6 +760,22 @@ public:
      */
     Options *GetOptionsObj() { return m_options; }
 
+    /**
+     * @name Return the JSON values of the corresponding methods without serializing them.
+     *
+     * Used by the bindings for building native structures directly instead of parsing the stringified JSON.
+     *
+     * @ingroup nodoc
+     */
+    ///@{
+    jsonxx::Array RenderToTimemapObj(const std::string &jsonOptions = "");
+    jsonxx::Object GetDescriptiveFeaturesObj(const std::string &jsonOptions);
+    jsonxx::Object GetElementsAtTimeObj(int millisec);
+    jsonxx::Object GetElementAttrObj(const std::string &xmlId);
+    jsonxx::Object GetMIDIValuesForElementObj(const std::string &xmlId);
+    jsonxx::Object GetTimesForElementObj(const std::string &xmlId);
+    ///@}
+
     /**
      * Copy the data to the cstring internal buffer.
      *
@@ -758,7 +866,7 @@ protected:
     /**
      * Identify the input file type for auto loading of input data
      */
-    FileFormat IdentifyInputFrom(const std::string &data);
+    FileFormat IdentifyInputFrom(std::string_view data);
 
     /**
      * Print formatted option usage for specific option to output stream.
@@ -782,19 +890,37 @@ protected:
     void LogRedirectStop();
 
     /**
-     * Load a string data with or without resetting the log buffer
+     * Load a string data with or without resetting the log buffer.
+     * The data is not copied and has to remain valid during the call.
      */
-    bool LoadData(const std::string &data, bool resetLogBuffer);
+    bool LoadData(std::string_view data, bool resetLogBuffer);
 
 private:
     bool SetFont(const std::string &fontName);
-    bool IsUTF16(const std::string &filename);
-    bool LoadUTF16File(const std::string &filename);
-    bool IsZip(const std::string &filename);
-    bool LoadZipFile(const std::string &filename);
-    bool LoadZipData(const std::vector<unsigned char> &bytes);
+    bool IsUTF16(std::string_view data);
+    bool LoadUTF16Data(std::string_view data);
+    bool IsZip(std::string_view data);
+    bool LoadZipBuffer(const unsigned char *data, size_t length);
+    bool LoadSnapshot(std::string_view data);
+    std::string GetSnapshotSignature() const;
     void GetClassIds(const std::vector<std::string> &classStrings, std::vector<ClassId> &classIds);
 
+    /**
+     * Set up the SVG device context according to the options
+     */
+    void InitSvgDeviceContext(SvgDeviceContext &svg);
+
+    /**
+     * Set the size of the device context and draw the current page of the view.
+     * The view can be another one than m_view when drawing concurrently.
+     */
+    void DrawPageToDeviceContext(View &view, DeviceContext *deviceContext);
+
+    /**
+     * Cast off the document according to the breaks option
+     */
+    void CastOffDocWithBreaks();
+
     /**
      * Return a dictionary of all the options
      *
@@ -840,6 +966,12 @@ private:
     RuntimeClock *m_runtimeClock;
 #endif
 
+    /** Profiling the functors and processing steps */
+    Profiler *m_profiler;
+
+    /** The layout of the snapshot being loaded, NULL otherwise */
+    const std::vector<CastOffRecord> *m_snapshotLayout;
+
     //----------------//
     // Static members //
     //----------------//
@@ -8,6 +8,7 @@
 #ifndef __VRV_RENDERER_H__
 #define __VRV_RENDERER_H__
 
+#include <mutex>
 #include <optional>
 
 #include "devicecontextbase.h"
@@ -168,6 +169,16 @@ public:
      */
     void SetPage(int pageIdx, bool doLayout = true);
 
+    /**
+     * Set the view for drawing its page concurrently with other views pointing to the same document.
+     * In that case, the drawing page of the document is not changed by SetPage and DrawCurrentPage, which
+     * means that all pages have to be laid out beforehand and SetPage called with doLayout = false.
+     * The mutex is shared by the views and locked when drawing elements that can also be drawn on
+     * another page (running elements and time spanning elements across systems).
+     * Passing NULL sets the view back to normal drawing.
+     */
+    void SetConcurrentDrawing(std::mutex *mutex) { m_concurrentMutex = mutex; }
+
     /**
      * Method that actually draw the current page.
      * This is the only drawing method that is public and that can be called for drawing.
@@ -183,6 +194,15 @@ public:
      */
     double GetPPUFactor() const;
 
+    /**
+     * @name Return the width and the height of the current page adjusted to its content.
+     * See Doc::GetAdjustedDrawingPageWidth and Doc::GetAdjustedDrawingPageHeight
+     */
+    ///@{
+    int GetAdjustedDrawingPageWidth() const;
+    int GetAdjustedDrawingPageHeight() const;
+    ///@}
+
     /**
      * @name Methods for calculating drawing positions
      * Defined in view_element.cpp
@@ -301,6 +321,14 @@ protected:
     void DrawLayerElement(DeviceContext *dc, LayerElement *element, Layer *layer, Staff *staff, Measure *measure);
     ///@}
 
+    /**
+     * Calculate the bounding boxes of a LayerElement from the glyph metrics instead of drawing it.
+     * Return false if the element has to be drawn, for example because it contains unsupported elements.
+     * With BOUNDINGBOXES_check, the values are compared to the ones obtained by drawing it.
+     * Defined in view_element.cpp
+     */
+    bool CalcLayerElementBBox(DeviceContext *dc, LayerElement *element, Layer *layer, Staff *staff, Measure *measure);
+
     /**
      * @name Methods for drawing LayerElement child classes.
      * They are base drawing methods that are called directly from DrawLayerElement
@@ -661,6 +689,11 @@ private:
      */
     data_STEMDIRECTION GetMensuralStemDir(Layer *layer, Note *note, int verticalCenter);
 
+    /**
+     * Return the page for m_pageIdx, setting it as drawing page of the document unless drawing concurrently
+     */
+    Page *GetPageToDraw();
+
 public:
     /** Document */
     Doc *m_doc;
@@ -702,6 +735,11 @@ protected:
      */
     ScoreDef m_drawingScoreDef;
 
+    /**
+     * The mutex shared with other views when drawing concurrently (NULL otherwise)
+     */
+    std::mutex *m_concurrentMutex;
+
 private:
     //----------------//
     // Static members //
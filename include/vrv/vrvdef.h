@@ -14,6 +14,7 @@
 #include <map>
 #include <set>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 //----------------------------------------------------------------------------
@@ -392,6 +393,8 @@ typedef std::map<std::string, std::function<Object *(void)>> MapOfStrConstructor
 
 typedef std::map<std::string, ClassId> MapOfStrClassIds;
 
+typedef std::unordered_map<std::string, const Object *> MapOfStrConstObjects;
+
 typedef std::vector<std::pair<LayerElement *, LayerElement *>> MeasureTieEndpoints;
 
 typedef bool (*NotePredicate)(const Note *);
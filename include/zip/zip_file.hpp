@@ -9451,6 +9451,12 @@ namespace miniz_cpp
             load(bytes);
         }
 
+        zip_file(const unsigned char *data, std::size_t size)
+            : zip_file()
+        {
+            load(data, size);
+        }
+
         ~zip_file()
         {
             reset();
@@ -9472,9 +9478,14 @@ namespace miniz_cpp
         }
 
         void load(const std::vector<unsigned char> &bytes)
+        {
+            load(bytes.data(), bytes.size());
+        }
+
+        void load(const unsigned char *data, std::size_t size)
         {
             reset();
-            buffer_.assign(bytes.begin(), bytes.end());
+            buffer_.assign(data, data + size);
             remove_comment();
             start_read();
         }
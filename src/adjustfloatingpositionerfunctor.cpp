@@ -48,6 +48,7 @@ FunctorCode AdjustFloatingPositionersFunctor::VisitStaffAlignment(StaffAlignment
             // For now just clear the overflowBelow, which avoids the overlap to be calculated. We could also keep them
             // and check if they are some lyrics in order to know if the overlap needs to be calculated or not.
             staffAlignment->ClearBBoxesBelow();
+            m_overflowIndexes.erase(staffAlignment);
         }
         return FUNCTOR_SIBLINGS;
     }
@@ -119,11 +120,19 @@ FunctorCode AdjustFloatingPositionersFunctor::VisitStaffAlignment(StaffAlignment
             if (m_classId == HAIRPIN) continue;
         }
 
+        const BoundingBoxIndex &overflowIndex
+            = this->GetOverflowIndex(staffAlignment, (place == STAFFREL_above), drawingUnit);
+
         // Find all the overflowing elements from the staff that overlap horizontally
-        for (auto i = overflowBoxes.begin(); i != overflowBoxes.end(); ++i) {
-            if (positioner->HasHorizontalOverlapWith(*i, drawingUnit)) {
+        // The index returns them in the order of the overflowing boxes
+        int left = 0;
+        int right = 0;
+        std::tie(left, right) = positioner->GetHorizontalOverlapRange(drawingUnit);
+        overflowIndex.FindHorizontalOverlaps(left, right, m_overlappingBoxes);
+        for (BoundingBox *box : m_overlappingBoxes) {
+            if (positioner->HasHorizontalOverlapWith(box, drawingUnit)) {
                 // update the yRel accordingly
-                positioner->CalcDrawingYRel(m_doc, staffAlignment, *i);
+                positioner->CalcDrawingYRel(m_doc, staffAlignment, box);
             }
         }
 
@@ -151,6 +160,7 @@ FunctorCode AdjustFloatingPositionersFunctor::VisitStaffAlignment(StaffAlignment
 FunctorCode AdjustFloatingPositionersFunctor::VisitSystem(System *system)
 {
     m_inBetween = false;
+    m_overflowIndexes.clear();
 
     AdjustFloatingPositionerGrpsFunctor adjustFloatingPositionerGrps(m_doc);
 
@@ -272,6 +282,58 @@ FunctorCode AdjustFloatingPositionersFunctor::VisitSystem(System *system)
     return FUNCTOR_SIBLINGS;
 }
 
+BoundingBoxIndex &AdjustFloatingPositionersFunctor::GetOverflowIndex(
+    StaffAlignment *staffAlignment, bool above, int drawingUnit)
+{
+    const ArrayOfBoundingBoxes &overflowAboveBoxes = staffAlignment->GetBBoxesAbove();
+    const ArrayOfBoundingBoxes &overflowBelowBoxes = staffAlignment->GetBBoxesBelow();
+
+    auto [iter, isNew] = m_overflowIndexes.try_emplace(staffAlignment);
+    OverflowBoxesIndex &overflowIndex = iter->second;
+    if (isNew) {
+        // The range covers the overflowing boxes and the positioners that will be added to them
+        int left = VRV_UNSET;
+        int right = VRV_UNSET;
+        auto extendRange = [&left, &right](const BoundingBox *box) {
+            if (!box->HasContentHorizontalBB()) return;
+            left = (left == VRV_UNSET) ? box->GetContentLeft() : std::min(left, box->GetContentLeft());
+            right = (right == VRV_UNSET) ? box->GetContentRight() : std::max(right, box->GetContentRight());
+        };
+        std::for_each(overflowAboveBoxes.begin(), overflowAboveBoxes.end(), extendRange);
+        std::for_each(overflowBelowBoxes.begin(), overflowBelowBoxes.end(), extendRange);
+        const ArrayOfFloatingPositioners &positioners = staffAlignment->GetFloatingPositioners();
+        std::for_each(positioners.begin(), positioners.end(), extendRange);
+        if (left == VRV_UNSET) left = right = 0;
+
+        const int columnWidth = 8 * drawingUnit;
+        overflowIndex.m_above.Reset(left, right, columnWidth);
+        overflowIndex.m_below.Reset(left, right, columnWidth);
+    }
+
+    // The boxes are only appended to the overflowing boxes, which are otherwise cleared with the index
+    BoundingBoxIndex &index = (above) ? overflowIndex.m_above : overflowIndex.m_below;
+    int &count = (above) ? overflowIndex.m_aboveCount : overflowIndex.m_belowCount;
+    const ArrayOfBoundingBoxes &boxes = (above) ? overflowAboveBoxes : overflowBelowBoxes;
+    assert(count <= (int)boxes.size());
+    for (; count < (int)boxes.size(); ++count) {
+        this->AddToIndex(index, boxes.at(count));
+    }
+
+    return index;
+}
+
+void AdjustFloatingPositionersFunctor::AddToIndex(BoundingBoxIndex &index, BoundingBox *box) const
+{
+    // Boxes without content never overlap
+    if (!box->HasContentBB()) return;
+
+    int extenderWidth = 0;
+    const FloatingPositioner *positioner = dynamic_cast<const FloatingPositioner *>(box);
+    if (positioner) extenderWidth = positioner->GetDrawingExtenderWidth();
+
+    index.Add(box, box->GetContentLeft(), box->GetContentRight() + extenderWidth);
+}
+
 //----------------------------------------------------------------------------
 // AdjustFloatingPositionerGrpsFunctor
 //----------------------------------------------------------------------------
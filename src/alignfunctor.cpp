@@ -459,8 +459,15 @@ FunctorCode AlignMeasuresFunctor::VisitMeasure(Measure *measure)
 
     measure->SetDrawingXRel(m_shift);
 
-    m_shift += measure->GetWidth();
-    m_justifiableWidth += measure->GetRightBarLineXRel() - measure->GetLeftBarLineXRel();
+    // When casting off, the cached layout is used because the aligners are reset when it is restored
+    if (m_storeCastOffSystemWidths && measure->HasCachedHorizontalLayout()) {
+        m_shift += measure->GetCachedWidth();
+        m_justifiableWidth += measure->GetCachedJustifiableWidth();
+    }
+    else {
+        m_shift += measure->GetWidth();
+        m_justifiableWidth += measure->GetRightBarLineXRel() - measure->GetLeftBarLineXRel();
+    }
 
     return FUNCTOR_SIBLINGS;
 }
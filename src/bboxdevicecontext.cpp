@@ -431,6 +431,28 @@ void BBoxDeviceContext::UpdateBB(int x1, int y1, int x2, int y2, char32_t glyph)
     }
 }
 
+bool BBoxDeviceContext::UpdateWithContentBB(const Object *object)
+{
+    if (m_isDeactivatedX || m_isDeactivatedY || !AreEqual(m_rotationAngle, 0.0)) {
+        return false;
+    }
+
+    // the array may not be empty
+    assert(!m_objects.empty());
+
+    // the values are already logical coordinates
+    for (Object *current : m_objects) {
+        if (object->HasContentHorizontalBB()) {
+            current->UpdateContentBBoxX(object->GetContentLeft(), object->GetContentRight());
+        }
+        if (object->HasContentVerticalBB()) {
+            current->UpdateContentBBoxY(object->GetContentBottom(), object->GetContentTop());
+        }
+    }
+
+    return true;
+}
+
 void BBoxDeviceContext::ResetGraphicRotation()
 {
     m_rotationAngle = 0.0;
@@ -66,6 +66,16 @@ void BeamSpan::Reset()
     ClearBeamSegments();
 }
 
+void BeamSpan::CloneReset()
+{
+    // Since these are owned by the beamSpan we cloned from, empty the lists
+    // Do it before Object::CloneReset since that one will reset them
+    m_beamElementCoords.clear();
+    m_beamSegments.clear();
+
+    ControlElement::CloneReset();
+}
+
 void BeamSpan::InitBeamSegments()
 {
     // BeamSpan should have at least one segment to begin with
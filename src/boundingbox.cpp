@@ -1258,4 +1258,105 @@ void SegmentedLine::AddGap(int start, int end)
     }
 }
 
+//----------------------------------------------------------------------------
+// BoundingBoxIndex
+//----------------------------------------------------------------------------
+
+BoundingBoxIndex::BoundingBoxIndex()
+{
+    this->Reset(0, 0, 1);
+}
+
+void BoundingBoxIndex::Reset(int left, int right, int columnWidth)
+{
+    assert(right >= left);
+    assert(columnWidth > 0);
+
+    // Keep the number of columns reasonable with very wide ranges
+    const int maxColumns = 1024;
+    m_left = left;
+    m_columnWidth = std::max(columnWidth, (right - left) / maxColumns + 1);
+
+    m_columns.clear();
+    m_columns.resize((right - left) / m_columnWidth + 1);
+    m_boxes.clear();
+    m_extents.clear();
+}
+
+void BoundingBoxIndex::Clear()
+{
+    for (std::vector<int> &column : m_columns) column.clear();
+    m_boxes.clear();
+    m_extents.clear();
+}
+
+int BoundingBoxIndex::GetColumn(int x) const
+{
+    if (x <= m_left) return 0;
+    return std::min((x - m_left) / m_columnWidth, (int)m_columns.size() - 1);
+}
+
+void BoundingBoxIndex::Add(BoundingBox *box, int x1, int x2, int y1, int y2)
+{
+    assert(box);
+
+    if (x1 > x2) std::swap(x1, x2);
+    if (y1 > y2) std::swap(y1, y2);
+
+    const int idx = (int)m_boxes.size();
+    m_boxes.push_back(box);
+    m_extents.push_back({ x1, x2, y1, y2 });
+
+    const int lastColumn = this->GetColumn(x2);
+    for (int column = this->GetColumn(x1); column <= lastColumn; ++column) {
+        m_columns.at(column).push_back(idx);
+    }
+}
+
+void BoundingBoxIndex::FindCandidates(int x1, int x2, std::vector<int> &candidates) const
+{
+    candidates.clear();
+
+    const int firstColumn = this->GetColumn(x1);
+    const int lastColumn = this->GetColumn(x2);
+    for (int column = firstColumn; column <= lastColumn; ++column) {
+        const std::vector<int> &indexes = m_columns.at(column);
+        candidates.insert(candidates.end(), indexes.begin(), indexes.end());
+    }
+    // A box covering several columns is registered in each of them
+    if (firstColumn != lastColumn) {
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+}
+
+void BoundingBoxIndex::FindHorizontalOverlaps(int x1, int x2, ArrayOfBoundingBoxes &boxes) const
+{
+    if (x1 > x2) std::swap(x1, x2);
+
+    std::vector<int> candidates;
+    this->FindCandidates(x1, x2, candidates);
+
+    boxes.clear();
+    for (int idx : candidates) {
+        const std::array<int, 4> &extent = m_extents.at(idx);
+        if ((extent[1] < x1) || (extent[0] > x2)) continue;
+        boxes.push_back(m_boxes.at(idx));
+    }
+}
+
+void BoundingBoxIndex::FindAt(int x, int y, ArrayOfBoundingBoxes &boxes) const
+{
+    std::vector<int> candidates;
+    this->FindCandidates(x, x, candidates);
+
+    boxes.clear();
+    for (int idx : candidates) {
+        const std::array<int, 4> &extent = m_extents.at(idx);
+        if ((extent[1] < x) || (extent[0] > x)) continue;
+        if ((extent[3] < y) || (extent[2] > y)) continue;
+        boxes.push_back(m_boxes.at(idx));
+    }
+}
+
 } // namespace vrv
@@ -0,0 +1,476 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        calcbboxfunctor.cpp
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "calcbboxfunctor.h"
+
+//----------------------------------------------------------------------------
+
+#include <cmath>
+
+//----------------------------------------------------------------------------
+
+#include "accid.h"
+#include "artic.h"
+#include "chord.h"
+#include "devicecontextbase.h"
+#include "doc.h"
+#include "elementpart.h"
+#include "glyph.h"
+#include "note.h"
+#include "resources.h"
+#include "rest.h"
+#include "smufl.h"
+#include "staff.h"
+#include "stem.h"
+#include "vrv.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// CalcBBoxFunctor
+//----------------------------------------------------------------------------
+
+CalcBBoxFunctor::CalcBBoxFunctor(Doc *doc, Staff *staff) : DocFunctor(doc)
+{
+    m_staff = staff;
+    m_calculated = true;
+    m_deactivatedX = false;
+    m_check = false;
+
+    this->SetVisibleOnly(false);
+}
+
+int CalcBBoxFunctor::CheckBoundingBoxes() const
+{
+    int differences = 0;
+    for (const auto &[element, values] : m_checkValues) {
+        const std::vector<int> drawn = { element->GetSelfX1(), element->GetSelfX2(), element->GetSelfY1(),
+            element->GetSelfY2(), element->GetContentX1(), element->GetContentX2(), element->GetContentY1(),
+            element->GetContentY2(), (int)element->GetBoundingBoxGlyph() };
+        if (drawn == values) continue;
+        LogWarning("Bounding box of %s '%s' calculated as [%d %d %d %d / %d %d %d %d] but drawn as "
+                   "[%d %d %d %d / %d %d %d %d]",
+            element->GetClassName().c_str(), element->GetID().c_str(), values.at(0), values.at(1), values.at(2),
+            values.at(3), values.at(4), values.at(5), values.at(6), values.at(7), drawn.at(0), drawn.at(1),
+            drawn.at(2), drawn.at(3), drawn.at(4), drawn.at(5), drawn.at(6), drawn.at(7));
+        ++differences;
+    }
+    return differences;
+}
+
+void CalcBBoxFunctor::StartElement(LayerElement *element, Staff *staff)
+{
+    element->BoundingBox::ResetBoundingBox();
+    m_elements.push_back({ element, staff });
+}
+
+void CalcBBoxFunctor::KeepBoundingBox(const LayerElement *element)
+{
+    if (!m_check) return;
+
+    m_checkValues.push_back({ element,
+        { element->GetSelfX1(), element->GetSelfX2(), element->GetSelfY1(), element->GetSelfY2(),
+            element->GetContentX1(), element->GetContentX2(), element->GetContentY1(), element->GetContentY2(),
+            (int)element->GetBoundingBoxGlyph() } });
+}
+
+void CalcBBoxFunctor::UpdateBB(int x1, int y1, int x2, int y2, char32_t glyph, int pointSize)
+{
+    assert(!m_elements.empty());
+
+    LayerElement *element = m_elements.back().first;
+    if (!m_deactivatedX) element->UpdateSelfBBoxX(x1, x2);
+    element->UpdateSelfBBoxY(y1, y2);
+    if (glyph != 0) element->SetBoundingBoxGlyph(glyph, pointSize);
+
+    for (auto &[current, staff] : m_elements) {
+        if (!m_deactivatedX) current->UpdateContentBBoxX(x1, x2);
+        current->UpdateContentBBoxY(y1, y2);
+    }
+}
+
+void CalcBBoxFunctor::CalcSmuflString(
+    int x, int y, const std::u32string &str, bool center, int staffSize, bool dimin, bool setBBGlyph)
+{
+    const FontInfo *font = m_doc->GetDrawingSmuflFont(staffSize, dimin);
+    const int pointSize = font->GetPointSize();
+    const Resources &resources = m_doc->GetResources();
+
+    // Same as in DeviceContext::GetSmuflTextExtent
+    if (center) {
+        int width = 0;
+        for (char32_t c : str) {
+            const Glyph *glyph = resources.GetGlyph(c);
+            if (!glyph) continue;
+            int gx, gy, gWidth, gHeight;
+            glyph->GetBoundingBox(gx, gy, gWidth, gHeight);
+            const int partialWidth = ceil(gWidth * pointSize / (double)glyph->GetUnitsPerEm());
+            const int advX = ceil(glyph->GetHorizAdvX() * pointSize / (double)glyph->GetUnitsPerEm());
+            if ((font->GetLetterSpacing() != 0) && (width > 0)) width += font->GetLetterSpacing();
+            width += (advX == 0) ? partialWidth : advX;
+        }
+        x -= width / 2;
+    }
+
+    // Same as in BBoxDeviceContext::DrawMusicText but with logical y coordinates
+    const char32_t bbGlyph = (setBBGlyph && (str.length() == 1)) ? str.at(0) : 0;
+    for (char32_t c : str) {
+        const Glyph *glyph = resources.GetGlyph(c);
+        if (!glyph) continue;
+        int gx, gy, gWidth, gHeight;
+        glyph->GetBoundingBox(gx, gy, gWidth, gHeight);
+        const int unitsPerEm = glyph->GetUnitsPerEm();
+        const int x1 = x + gx * pointSize / unitsPerEm;
+        const int y1 = y + gy * pointSize / unitsPerEm;
+        this->UpdateBB(
+            x1, y1, x1 + gWidth * pointSize / unitsPerEm, y1 + gHeight * pointSize / unitsPerEm, bbGlyph, pointSize);
+        x += glyph->GetHorizAdvX() * pointSize / unitsPerEm;
+    }
+}
+
+void CalcBBoxFunctor::CalcLine(int x1, int y1, int x2, int y2, int width)
+{
+    if (x1 > x2) std::swap(x1, x2);
+    if (y1 > y2) std::swap(y1, y2);
+
+    // Same as in BBoxDeviceContext::GetPenWidthOverlap
+    const int penWidth = std::max(1, width);
+    const int p1 = penWidth / 2 + (penWidth % 2);
+    const int p2 = penWidth / 2;
+
+    this->UpdateBB(x1 - p1, y1 - p1, x2 + p2, y2 + p2);
+}
+
+void CalcBBoxFunctor::CalcDotsPart(int x, int y, unsigned char dots, const Staff *staff, bool dimin)
+{
+    // Same as View::DrawDotsPart and View::DrawDot
+    const int unit = m_doc->GetDrawingUnit(staff->m_drawingStaffSize);
+    if (staff->IsOnStaffLine(y, m_doc)) {
+        y += unit;
+    }
+    const double distance = dimin ? m_doc->GetOptions()->m_graceFactor.GetValue() : 1.0;
+    int radius = std::max(m_doc->GetDrawingDoubleUnit(staff->m_drawingStaffSize) / 5, 2);
+    if (dimin) radius *= m_doc->GetOptions()->m_graceFactor.GetValue();
+    for (int i = 0; i < dots; ++i) {
+        this->UpdateBB(x - radius, y - radius, x + radius, y + radius);
+        x += unit * 1.5 * distance;
+    }
+}
+
+FunctorCode CalcBBoxFunctor::VisitAccid(Accid *accid)
+{
+    Staff *staff = m_elements.empty() ? m_staff : m_elements.back().second;
+
+    if (!accid->HasAccid() || staff->IsTablature()) {
+        accid->BoundingBox::ResetBoundingBox();
+        accid->SetEmptyBB();
+        this->KeepBoundingBox(accid);
+        return FUNCTOR_SIBLINGS;
+    }
+
+    // Accidentals placed above or below the note are not supported
+    if (accid->HasPlace() || accid->HasOnstaff() || (accid->GetFunc() == accidLog_FUNC_edit)) {
+        m_calculated = false;
+        return FUNCTOR_STOP;
+    }
+
+    this->StartElement(accid, staff);
+
+    this->CalcSmuflString(accid->GetDrawingX(), accid->GetDrawingY(),
+        accid->GetSymbolStr(staff->m_drawingNotationType), true, staff->m_drawingStaffSize,
+        accid->GetDrawingCueSize(), true);
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode CalcBBoxFunctor::VisitArtic(Artic *artic)
+{
+    Staff *staff = m_elements.empty() ? m_staff : m_elements.back().second;
+
+    // Same as in View::DrawArtic
+    const int staffSize = staff->m_drawingStaffSize;
+    const bool drawingCueSize = artic->GetDrawingCueSize();
+    const data_ARTICULATION articValue = artic->GetArticFirst();
+    const data_STAFFREL place = artic->GetDrawingPlace();
+
+    const char32_t code = artic->GetArticGlyph(articValue, place);
+    if (code == 0) {
+        artic->SetEmptyBB();
+        this->KeepBoundingBox(artic);
+        return FUNCTOR_SIBLINGS;
+    }
+
+    const auto [enclosingFront, enclosingBack] = artic->GetEnclosingGlyphs();
+
+    const int x = artic->GetDrawingX();
+    int y = artic->GetDrawingY();
+
+    const int xCorr = m_doc->GetGlyphWidth(code, staffSize, drawingCueSize) / 2;
+    const int glyphHeight = m_doc->GetGlyphHeight(code, staffSize, drawingCueSize);
+
+    int exceedingHeight = 0;
+    for (const char32_t symbol : { enclosingFront, enclosingBack }) {
+        if (symbol == 0) continue;
+        const int symbolHeight = m_doc->GetGlyphHeight(symbol, staffSize, drawingCueSize);
+        exceedingHeight = std::max(exceedingHeight, symbolHeight - glyphHeight);
+    }
+
+    int yCorr = 0;
+    if (Artic::IsCentered(articValue) && !enclosingFront && !enclosingBack) {
+        y += (place == STAFFREL_above) ? -(glyphHeight / 2) : (glyphHeight / 2);
+    }
+    else {
+        y += (place == STAFFREL_above) ? (exceedingHeight / 2) : -(exceedingHeight / 2);
+        if ((artic->HasGlyphNum() || artic->HasGlyphName()) && (place == STAFFREL_below)) {
+            yCorr += glyphHeight;
+        }
+    }
+
+    int yCorrEncl = (place == STAFFREL_above) ? -(glyphHeight / 2) : (glyphHeight / 2);
+    if (Artic::VerticalCorr(code, place)) {
+        y -= glyphHeight;
+        yCorrEncl = -glyphHeight / 2;
+    }
+
+    this->StartElement(artic, staff);
+
+    if (enclosingFront) {
+        int xCorrEncl = std::max(xCorr, m_doc->GetDrawingUnit(staffSize) * 2 / 3);
+        xCorrEncl += m_doc->GetGlyphWidth(enclosingFront, staffSize, drawingCueSize);
+        this->CalcSmuflString(
+            x - xCorrEncl, y - yCorrEncl, std::u32string(1, enclosingFront), false, staffSize, drawingCueSize);
+    }
+
+    this->CalcSmuflString(x - xCorr, y - yCorr, std::u32string(1, code), false, staffSize, drawingCueSize);
+
+    if (enclosingBack) {
+        const int xCorrEncl = std::max(xCorr, m_doc->GetDrawingUnit(staffSize) * 2 / 3);
+        this->CalcSmuflString(
+            x + xCorrEncl, y - yCorrEncl, std::u32string(1, enclosingBack), false, staffSize, drawingCueSize);
+    }
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode CalcBBoxFunctor::VisitChord(Chord *chord)
+{
+    if (chord->HasCluster()) {
+        m_calculated = false;
+        return FUNCTOR_STOP;
+    }
+
+    Staff *staff = m_elements.empty() ? m_staff : m_elements.back().second;
+    if (chord->m_crossStaff) staff = chord->m_crossStaff;
+
+    this->StartElement(chord, staff);
+
+    chord->ResetDrawingList();
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode CalcBBoxFunctor::VisitDots(Dots *dots)
+{
+    Staff *staff = m_elements.empty() ? m_staff : m_elements.back().second;
+
+    if (staff->IsMensural()) {
+        m_calculated = false;
+        return FUNCTOR_STOP;
+    }
+
+    this->StartElement(dots, staff);
+
+    const int unit = m_doc->GetDrawingUnit(staff->m_drawingStaffSize);
+    for (const auto &mapEntry : dots->GetMapOfDotLocs()) {
+        const Staff *dotStaff = (mapEntry.first) ? mapEntry.first : staff;
+        if (dotStaff->IsMensural()) {
+            m_calculated = false;
+            return FUNCTOR_STOP;
+        }
+        const int y = dotStaff->GetDrawingY()
+            - m_doc->GetDrawingDoubleUnit(staff->m_drawingStaffSize) * (dotStaff->m_drawingLines - 1);
+        const int x = dots->GetDrawingX() + unit;
+        for (int loc : mapEntry.second) {
+            this->CalcDotsPart(x, y + loc * unit, dots->GetDots(), dotStaff, dots->GetDrawingCueSize());
+        }
+    }
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode CalcBBoxFunctor::VisitFlag(Flag *flag)
+{
+    Staff *staff = m_elements.empty() ? m_staff : m_elements.back().second;
+
+    Stem *stem = vrv_cast<Stem *>(flag->GetFirstAncestor(STEM));
+    assert(stem);
+
+    this->StartElement(flag, staff);
+
+    const int x = flag->GetDrawingX() - m_doc->GetDrawingStemWidth(staff->m_drawingStaffSize) / 2;
+    const char32_t code = flag->GetFlagGlyph(stem->GetDrawingStemDir());
+    if (code != 0) {
+        this->CalcSmuflString(
+            x, flag->GetDrawingY(), std::u32string(1, code), false, staff->GetDrawingStaffNotationSize(),
+            flag->GetDrawingCueSize());
+    }
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode CalcBBoxFunctor::VisitLayerElementEnd(LayerElement *layerElement)
+{
+    if (!m_calculated) return FUNCTOR_STOP;
+
+    assert(!m_elements.empty() && (m_elements.back().first == layerElement));
+    m_elements.pop_back();
+
+    this->KeepBoundingBox(layerElement);
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode CalcBBoxFunctor::VisitNote(Note *note)
+{
+    // Mensural notes, tablature notes, notes sharing a stem, and notehead enclosures are not supported
+    if (note->IsMensuralDur() || note->IsTabGrpNote() || note->HasStemSameasNote()
+        || (note->GetHeadMod() == NOTEHEADMODIFIER_paren)) {
+        m_calculated = false;
+        return FUNCTOR_STOP;
+    }
+
+    int drawingDur = note->GetDrawingDur();
+    if (drawingDur == DUR_NONE) drawingDur = DUR_4;
+    if (drawingDur < DUR_BR) {
+        m_calculated = false;
+        return FUNCTOR_STOP;
+    }
+
+    Staff *staff = m_elements.empty() ? m_staff : m_elements.back().second;
+    if (note->m_crossStaff) staff = note->m_crossStaff;
+
+    this->StartElement(note, staff);
+
+    if (note->GetHeadVisible() == BOOLEAN_false) return FUNCTOR_CONTINUE;
+
+    // Same as in View::DrawNote
+    char32_t code;
+    if (note->GetColored() == BOOLEAN_true) {
+        if (DUR_1 == drawingDur) {
+            code = SMUFL_E0FA_noteheadWholeFilled;
+        }
+        else if (DUR_2 == drawingDur) {
+            code = SMUFL_E0FB_noteheadHalfFilled;
+        }
+        else {
+            code = SMUFL_E0A3_noteheadHalf;
+        }
+    }
+    else {
+        code = note->GetNoteheadGlyph(drawingDur);
+    }
+    if (code != 0) {
+        this->CalcSmuflString(note->GetDrawingX(), note->GetDrawingY(), std::u32string(1, code), false,
+            staff->m_drawingStaffSize, note->GetDrawingCueSize(), true);
+    }
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode CalcBBoxFunctor::VisitObject(Object *object)
+{
+    // Labels are not drawn as children of layer elements
+    if (object->Is({ LABEL, LABELABBR })) return FUNCTOR_SIBLINGS;
+
+    m_calculated = false;
+    return FUNCTOR_STOP;
+}
+
+FunctorCode CalcBBoxFunctor::VisitRest(Rest *rest)
+{
+    Staff *staff = m_elements.empty() ? m_staff : m_elements.back().second;
+    if (rest->m_crossStaff) staff = rest->m_crossStaff;
+
+    this->StartElement(rest, staff);
+
+    // Same as in View::DrawRest
+    const bool drawingCueSize = rest->GetDrawingCueSize();
+    const int staffSize = staff->GetDrawingStaffNotationSize();
+    int drawingDur = rest->GetActualDur();
+    if (drawingDur == DUR_NONE) drawingDur = DUR_4;
+    const char32_t drawingGlyph = rest->GetRestGlyph(drawingDur);
+
+    const int x = rest->GetDrawingX();
+    const int y = rest->GetDrawingY();
+
+    if (drawingGlyph != 0) {
+        this->CalcSmuflString(x, y, std::u32string(1, drawingGlyph), false, staffSize, drawingCueSize);
+    }
+
+    if ((drawingDur == DUR_1 || drawingDur == DUR_2 || drawingDur == DUR_BR)) {
+        const int width = m_doc->GetGlyphWidth(drawingGlyph, staffSize, drawingCueSize);
+        int ledgerLineThickness
+            = m_doc->GetOptions()->m_ledgerLineThickness.GetValue() * m_doc->GetDrawingUnit(staffSize);
+        int ledgerLineExtension
+            = m_doc->GetOptions()->m_ledgerLineExtension.GetValue() * m_doc->GetDrawingUnit(staffSize);
+        if (drawingCueSize) {
+            ledgerLineThickness *= m_doc->GetOptions()->m_graceFactor.GetValue();
+            ledgerLineExtension *= m_doc->GetOptions()->m_graceFactor.GetValue();
+        }
+        const int topMargin = staff->GetDrawingY();
+        const int bottomMargin
+            = staff->GetDrawingY() - (staff->m_drawingLines - 1) * m_doc->GetDrawingDoubleUnit(staffSize);
+
+        // Ledger lines are not taken into account horizontally
+        m_deactivatedX = true;
+        const int x1 = x - ledgerLineExtension;
+        const int x2 = x + width + ledgerLineExtension;
+        if ((drawingDur == DUR_1 || drawingDur == DUR_2) && (y > topMargin || y < bottomMargin)) {
+            this->CalcLine(x1, y, x2, y, ledgerLineThickness);
+        }
+        else if (drawingDur == DUR_BR && (y >= topMargin || y <= bottomMargin)) {
+            const int height = m_doc->GetGlyphHeight(drawingGlyph, staffSize, drawingCueSize);
+            if (y != topMargin) {
+                this->CalcLine(x1, y, x2, y, ledgerLineThickness);
+            }
+            if (y != bottomMargin - height) {
+                this->CalcLine(x1, y + height, x2, y + height, ledgerLineThickness);
+            }
+        }
+        m_deactivatedX = false;
+    }
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode CalcBBoxFunctor::VisitStem(Stem *stem)
+{
+    // Mensural stems, stem modifiers and acciaccatura slashes are not supported
+    const Note *parent = vrv_cast<Note *>(stem->GetFirstAncestor(NOTE));
+    if ((parent && parent->IsMensuralDur())
+        || ((stem->GetDrawingStemMod() != STEMMODIFIER_NONE) && (stem->GetDrawingStemMod() != STEMMODIFIER_none))
+        || ((stem->GetGrace() == GRACE_unacc) && !stem->IsInBeam())) {
+        m_calculated = false;
+        return FUNCTOR_STOP;
+    }
+
+    // Virtual stems are not drawn
+    if (stem->IsVirtual()) return FUNCTOR_SIBLINGS;
+
+    Staff *staff = m_elements.empty() ? m_staff : m_elements.back().second;
+
+    this->StartElement(stem, staff);
+
+    const int y = stem->GetDrawingY();
+    this->CalcLine(stem->GetDrawingX(), y, stem->GetDrawingX(),
+        y - (stem->GetDrawingStemLen() + stem->GetDrawingStemAdjust()),
+        m_doc->GetDrawingStemWidth(staff->m_drawingStaffSize));
+
+    return FUNCTOR_CONTINUE;
+}
+
+} // namespace vrv
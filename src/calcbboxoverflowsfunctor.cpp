@@ -9,13 +9,21 @@
 
 //----------------------------------------------------------------------------
 
+#include "controlelement.h"
 #include "doc.h"
+#include "floatingobject.h"
 #include "layer.h"
+#include "measure.h"
 #include "staff.h"
+#include "stem.h"
+#include "timeinterface.h"
 #include "verticalaligner.h"
 
 //----------------------------------------------------------------------------
 
+/** The estimated height of a line of floating elements in drawing units */
+#define ESTIMATED_FLOATING_LINE_HEIGHT 4
+
 namespace vrv {
 
 //----------------------------------------------------------------------------
@@ -171,4 +179,102 @@ FunctorCode CalcBBoxOverflowsFunctor::VisitObject(Object *object)
     return FUNCTOR_CONTINUE;
 }
 
+//----------------------------------------------------------------------------
+// EstimateBBoxOverflowsFunctor
+//----------------------------------------------------------------------------
+
+EstimateBBoxOverflowsFunctor::EstimateBBoxOverflowsFunctor(Doc *doc) : DocFunctor(doc)
+{
+    m_currentMeasure = NULL;
+}
+
+FunctorCode EstimateBBoxOverflowsFunctor::VisitControlElement(ControlElement *controlElement)
+{
+    // Curves remain close to the notes and are ignored
+    if (controlElement->Is({ LV, PHRASE, SLUR, TIE })) return FUNCTOR_SIBLINGS;
+
+    TimePointInterface *interface = controlElement->GetTimePointInterface();
+    if (!interface || !m_currentMeasure) return FUNCTOR_SIBLINGS;
+
+    for (Staff *staff : interface->GetTstampStaves(m_currentMeasure, controlElement)) {
+        StaffAlignment *alignment = staff->GetAlignment();
+        if (!alignment) continue;
+        // Use a positioner only for getting the place of the element
+        const FloatingPositioner positioner(controlElement, alignment, SPANNING_START_END);
+        if (positioner.GetDrawingPlace() == STAFFREL_above) {
+            m_classesAbove[alignment].insert(controlElement->GetClassId());
+        }
+        else if (positioner.GetDrawingPlace() == STAFFREL_below) {
+            m_classesBelow[alignment].insert(controlElement->GetClassId());
+        }
+    }
+
+    return FUNCTOR_SIBLINGS;
+}
+
+FunctorCode EstimateBBoxOverflowsFunctor::VisitLayerElement(LayerElement *layerElement)
+{
+    if (!layerElement->Is({ NOTE, REST, STEM })) return FUNCTOR_CONTINUE;
+
+    StaffAlignment *above = NULL;
+    StaffAlignment *below = NULL;
+    layerElement->GetOverflowStaffAlignments(above, below);
+
+    int top = layerElement->GetDrawingY();
+    int bottom = top;
+    // Half of a note head, or nothing for stems
+    int margin = 1;
+    if (layerElement->Is(STEM)) {
+        const Stem *stem = vrv_cast<Stem *>(layerElement);
+        assert(stem);
+        if (stem->IsVirtual()) return FUNCTOR_CONTINUE;
+        // The stem goes from its drawing y in the direction of its (signed) length (see View::DrawStem)
+        const int end = top - (stem->GetDrawingStemLen() + stem->GetDrawingStemAdjust());
+        top = std::max(top, end);
+        bottom = std::min(bottom, end);
+        margin = 0;
+    }
+
+    if (above && above->GetStaff()) {
+        const int overflowAbove = top + margin * m_doc->GetDrawingUnit(above->GetStaffSize()) - above->GetYRel();
+        above->SetOverflowAbove(overflowAbove);
+    }
+    if (below && below->GetStaff()) {
+        const int bottomMargin = margin * m_doc->GetDrawingUnit(below->GetStaffSize());
+        const int overflowBelow = -(bottom - bottomMargin + below->GetStaffHeight() - below->GetYRel());
+        below->SetOverflowBelow(overflowBelow);
+    }
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode EstimateBBoxOverflowsFunctor::VisitMeasure(Measure *measure)
+{
+    m_currentMeasure = measure;
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode EstimateBBoxOverflowsFunctor::VisitStaff(Staff *staff)
+{
+    return (staff->DrawingIsVisible()) ? FUNCTOR_CONTINUE : FUNCTOR_SIBLINGS;
+}
+
+FunctorCode EstimateBBoxOverflowsFunctor::VisitSystemEnd(System *system)
+{
+    // Floating elements of different classes are placed on separate lines beyond the content of the staff
+    for (auto &[alignment, classIds] : m_classesAbove) {
+        const int lineHeight = ESTIMATED_FLOATING_LINE_HEIGHT * m_doc->GetDrawingUnit(alignment->GetStaffSize());
+        alignment->SetOverflowAbove(alignment->GetOverflowAbove() + (int)classIds.size() * lineHeight);
+    }
+    for (auto &[alignment, classIds] : m_classesBelow) {
+        const int lineHeight = ESTIMATED_FLOATING_LINE_HEIGHT * m_doc->GetDrawingUnit(alignment->GetStaffSize());
+        alignment->SetOverflowBelow(alignment->GetOverflowBelow() + (int)classIds.size() * lineHeight);
+    }
+    m_classesAbove.clear();
+    m_classesBelow.clear();
+
+    return FUNCTOR_CONTINUE;
+}
+
 } // namespace vrv
@@ -550,6 +550,7 @@ FunctorCode UnCastOffFunctor::VisitMeasure(Measure *measure)
         measure->ResetCachedXRel();
         measure->ResetCachedWidth();
         measure->ResetCachedOverflow();
+        measure->SetDirty(false);
     }
 
     return FUNCTOR_CONTINUE;
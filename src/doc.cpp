@@ -10,6 +10,7 @@
 //----------------------------------------------------------------------------
 
 #include <cassert>
+#include <chrono>
 #include <math.h>
 
 //----------------------------------------------------------------------------
@@ -17,6 +18,7 @@
 #include "alignfunctor.h"
 #include "barline.h"
 #include "beatrpt.h"
+#include "cachehorizontallayoutfunctor.h"
 #include "castofffunctor.h"
 #include "chord.h"
 #include "comparison.h"
@@ -25,6 +27,7 @@
 #include "expansion.h"
 #include "facsimilefunctor.h"
 #include "featureextractor.h"
+#include "findfunctor.h"
 #include "functor.h"
 #include "glyph.h"
 #include "instrdef.h"
@@ -45,11 +48,13 @@
 #include "multirest.h"
 #include "multirpt.h"
 #include "note.h"
+#include "objectarena.h"
 #include "page.h"
 #include "pages.h"
 #include "pgfoot.h"
 #include "pghead.h"
 #include "preparedatafunctor.h"
+#include "profiler.h"
 #include "resetfunctor.h"
 #include "runningelement.h"
 #include "score.h"
@@ -77,6 +82,7 @@
 
 #include "MidiEvent.h"
 #include "MidiFile.h"
+#include "jsonxx.h"
 
 namespace vrv {
 
@@ -84,6 +90,10 @@ namespace vrv {
 // Doc
 //----------------------------------------------------------------------------
 
+thread_local FontInfo Doc::s_drawingSmuflFont;
+thread_local FontInfo Doc::s_drawingLyricFont;
+thread_local FontInfo Doc::s_fingeringFont;
+
 Doc::Doc() : Object(DOC, "doc-")
 {
     m_options = new Options();
@@ -91,6 +101,7 @@ Doc::Doc() : Object(DOC, "doc-")
     // owned pointers need to be set to NULL;
     m_selectionPreceding = NULL;
     m_selectionFollowing = NULL;
+    m_objectArena = NULL;
 
     this->Reset();
 }
@@ -100,6 +111,9 @@ Doc::~Doc()
     this->ClearSelectionPages();
 
     delete m_options;
+
+    // The arena is deleted once the remaining objects (children, score def) are deleted
+    if (m_objectArena) m_objectArena->Release();
 }
 
 void Doc::Reset()
@@ -144,6 +158,24 @@ void Doc::Reset()
     m_header.reset();
     m_front.reset();
     m_back.reset();
+
+    m_idIndex.clear();
+    m_idIndexRevision = 0;
+    m_idIndexStaleRevision = 0;
+
+    // Release the memory in bulk if all the objects have been deleted
+    if (m_objectArena) m_objectArena->ReleaseChunks();
+}
+
+void Doc::SetObjectArena(bool useObjectArena)
+{
+    if (useObjectArena && !m_objectArena) {
+        m_objectArena = new ObjectArena();
+    }
+    else if (!useObjectArena && m_objectArena) {
+        m_objectArena->Release();
+        m_objectArena = NULL;
+    }
 }
 
 void Doc::ClearSelectionPages()
@@ -430,18 +462,19 @@ void Doc::ExportMIDI(smf::MidiFile *midiFile)
     this->Process(initProcessingLists);
     const IntTree &layerTree = initProcessingLists.GetLayerTree();
 
-    // The tree is used to process each staff/layer/verse separately
-    // For this, we use a array of AttNIntegerComparison that looks for each object if it is of the type
-    // and with @n specified
-
+    // The tree is used to assign each staff/layer to a MIDI track and channel
     IntTree_t::const_iterator staves;
     IntTree_t::const_iterator layers;
 
-    // Process notes and chords, rests, spaces layer by layer
+    // Process notes and chords, rests, spaces of all layers in a single traversal
     // track 0 (included by default) is reserved for meta messages common to all tracks
+    GenerateMIDIFunctor generateMIDI(midiFile);
+    generateMIDI.SetCurrentTempo(tempo);
+    generateMIDI.SetDeferredNotes(initMIDI.GetDeferredNotes());
+    generateMIDI.SetCueExclusion(this->GetOptions()->m_midiNoCue.GetValue());
+
     int midiChannel = 0;
     int midiTrack = 1;
-    Filters filters;
     for (staves = layerTree.child.begin(); staves != layerTree.child.end(); ++staves) {
         int transSemi = 0;
         if (StaffDef *staffDef = scoreDef->GetStaffDef(staves->first)) {
@@ -509,31 +542,26 @@ void Doc::ExportMIDI(smf::MidiFile *midiFile)
         scoreDef->Process(generateScoreDefMIDI);
 
         for (layers = staves->second.child.begin(); layers != staves->second.child.end(); ++layers) {
-            filters.Clear();
-            // Create ad comparison object for each type / @n
-            AttNIntegerComparison matchStaff(STAFF, staves->first);
-            AttNIntegerComparison matchLayer(LAYER, layers->first);
-            filters.Add(&matchStaff);
-            filters.Add(&matchLayer);
-
-            GenerateMIDIFunctor generateMIDI(midiFile);
-            generateMIDI.SetFilters(&filters);
-
-            generateMIDI.SetChannel(midiChannel);
-            generateMIDI.SetTrack(midiTrack);
-            generateMIDI.SetStaffN(staves->first);
-            generateMIDI.SetTransSemi(transSemi);
-            generateMIDI.SetCurrentTempo(tempo);
-            generateMIDI.SetDeferredNotes(initMIDI.GetDeferredNotes());
-            generateMIDI.SetCueExclusion(this->GetOptions()->m_midiNoCue.GetValue());
-
-            // LogDebug("Exporting track %d ----------------", midiTrack);
-            this->Process(generateMIDI);
+            generateMIDI.AddLayer(staves->first, layers->first, midiTrack, midiChannel, transSemi);
         }
     }
+
+    this->Process(generateMIDI);
 }
 
 bool Doc::ExportTimemap(std::string &output, bool includeRests, bool includeMeasures)
+{
+    jsonxx::Array timemap;
+    if (!this->ExportTimemap(timemap, includeRests, includeMeasures)) {
+        output = "{}";
+        return false;
+    }
+    output = timemap.json();
+
+    return true;
+}
+
+bool Doc::ExportTimemap(jsonxx::Array &output, bool includeRests, bool includeMeasures)
 {
     if (!this->HasTimemap()) {
         // generate MIDI timemap before progressing
@@ -541,7 +569,6 @@ bool Doc::ExportTimemap(std::string &output, bool includeRests, bool includeMeas
     }
     if (!this->HasTimemap()) {
         LogWarning("Calculation of the timemap failed, the timemap cannot be exported.");
-        output = "{}";
         return false;
     }
     Timemap timemap;
@@ -565,6 +592,19 @@ bool Doc::ExportExpansionMap(std::string &output)
 }
 
 bool Doc::ExportFeatures(std::string &output, const std::string &options)
+{
+    jsonxx::Object features;
+    if (!this->ExportFeatures(features, options)) {
+        output = "{}";
+        return false;
+    }
+    output = features.json();
+    LogDebug("%s", output.c_str());
+
+    return true;
+}
+
+bool Doc::ExportFeatures(jsonxx::Object &output, const std::string &options)
 {
     if (!this->HasTimemap()) {
         // generate MIDI timemap before progressing
@@ -572,7 +612,6 @@ bool Doc::ExportFeatures(std::string &output, const std::string &options)
     }
     if (!this->HasTimemap()) {
         LogWarning("Calculation of the timemap failed, the features cannot be exported.");
-        output = "{}";
         return false;
     }
     FeatureExtractor extractor(options);
@@ -585,6 +624,19 @@ bool Doc::ExportFeatures(std::string &output, const std::string &options)
 
 void Doc::PrepareData()
 {
+    ProfilerStep profilerStep("Doc::PrepareData");
+
+    // The time spent in each stage is reported with the info log level and to the profiler
+    std::chrono::steady_clock::time_point stageStart = std::chrono::steady_clock::now();
+    auto logStageTime = [&stageStart](const char *stage) {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        LogInfo("Preparing data (%s): %.3fms", stage,
+            std::chrono::duration<double, std::milli>(now - stageStart).count());
+        Profiler *profiler = Profiler::GetActive();
+        if (profiler) profiler->AddStep(StringFormat("Doc::PrepareData (%s)", stage), stageStart, now);
+        stageStart = now;
+    };
+
     /************ Reset and initialization ************/
 
     if (m_dataPreparationDone) {
@@ -602,16 +654,18 @@ void Doc::PrepareData()
 
     this->CollectVisibleScores();
 
-    /************ Store default durations ************/
+    logStageTime("initialization");
 
-    PrepareDurationFunctor prepareDuration;
-    this->Process(prepareDuration);
-
-    /************ Resolve @startid / @endid ************/
+    /************ Store default durations and resolve @startid / @endid ************/
 
-    // Try to match all spanning elements (slur, tie, etc) by processing backwards
+    // The default durations, the first pass for matching all spanning elements (slur, tie, etc) and the <reh>
+    // positions are independent from each other and processed in a single traversal.
+    // <reh> elements can be encoded without @startid or @tstamp, but we need one internally for placement. They need
+    // to be resolved before the time pointing elements.
+    PrepareDurationFunctor prepareDuration;
     PrepareTimeSpanningFunctor prepareTimeSpanning;
-    this->Process(prepareTimeSpanning);
+    PrepareRehPositionFunctor prepareRehPosition;
+    this->Process({ &prepareDuration, &prepareTimeSpanning, &prepareRehPosition });
     prepareTimeSpanning.SetDataCollectionCompleted();
 
     // First we try a forward pass which should collect most of the spanning elements.
@@ -633,23 +687,31 @@ void Doc::PrepareData()
         LogWarning("%d time spanning element(s) with startid and endid could not be matched.", unmatchedElements);
     }
 
-    /************ Resolve @startid (only) ************/
+    logStageTime("durations and time spanning");
 
-    // Resolve <reh> elements first, since they can be encoded without @startid or @tstamp, but we need one internally
-    // for placement
-    PrepareRehPositionFunctor prepareRehPosition;
-    this->Process(prepareRehPosition);
+    /************ Resolve @startid (only) ************/
 
     // Try to match all time pointing elements (tempo, fermata, etc) by processing backwards
     PrepareTimePointingFunctor prepareTimePointing;
     prepareTimePointing.SetDirection(BACKWARD);
     this->Process(prepareTimePointing);
 
-    /************ Resolve @tstamp / tstamp2 ************/
+    logStageTime("time pointing");
+
+    /************ Resolve @tstamp / tstamp2, linking, @plist, cross staff and pedals ************/
 
     // Now try to match the @tstamp and @tstamp2 attributes.
+    // In the same traversal, try to match all pointing elements using @next, @sameas and @stem.sameas, collect the
+    // @plist references, prepare the cross-staff pointers and match the pedal lines. Pedal lines are matched at the
+    // end of each measure and need their @tstamp to be resolved first.
     PrepareTimestampsFunctor prepareTimestamps;
-    this->Process(prepareTimestamps);
+    PrepareLinkingFunctor prepareLinking;
+    PreparePlistFunctor preparePlist;
+    PrepareCrossStaffFunctor prepareCrossStaff;
+    PreparePedalsFunctor preparePedals(this);
+    this->Process({ &prepareTimestamps, &prepareLinking, &preparePlist, &prepareCrossStaff, &preparePedals });
+    prepareLinking.SetDataCollectionCompleted();
+    preparePlist.SetDataCollectionCompleted();
 
     // If some are still there, then it is probably an issue in the encoding
     if (!prepareTimestamps.GetInterfaceIDPairs().empty()) {
@@ -657,14 +719,7 @@ void Doc::PrepareData()
             prepareTimestamps.GetInterfaceIDPairs().size());
     }
 
-    /************ Resolve linking (@next) ************/
-
-    // Try to match all pointing elements using @next, @sameas and @stem.sameas
-    PrepareLinkingFunctor prepareLinking;
-    this->Process(prepareLinking);
-    prepareLinking.SetDataCollectionCompleted();
-
-    // If we have some left process again backward
+    // If we have some links left process again backward
     if (!prepareLinking.GetSameasIDPairs().empty() || !prepareLinking.GetStemSameasIDPairs().empty()) {
         prepareLinking.SetDirection(BACKWARD);
         this->Process(prepareLinking);
@@ -682,13 +737,6 @@ void Doc::PrepareData()
             prepareLinking.GetStemSameasIDPairs().size());
     }
 
-    /************ Resolve @plist ************/
-
-    // Try to match all pointing elements using @plist
-    PreparePlistFunctor preparePlist;
-    this->Process(preparePlist);
-    preparePlist.SetDataCollectionCompleted();
-
     // Process plist after all pairs have been collected
     if (!preparePlist.GetInterfaceIDPairs().empty()) {
         this->Process(preparePlist);
@@ -699,21 +747,15 @@ void Doc::PrepareData()
         LogWarning("%d element(s) with a @plist could not match the target", preparePlist.GetInterfaceIDPairs().size());
     }
 
-    /************ Resolve cross staff ************/
-
-    // Prepare the cross-staff pointers
-    PrepareCrossStaffFunctor prepareCrossStaff;
-    this->Process(prepareCrossStaff);
+    logStageTime("timestamps, linking and cross staff");
 
     /************ Resolve beamspan elements ***********/
 
+    // This needs the @plist references and the cross-staff pointers of all the elements to be resolved
     PrepareBeamSpanElementsFunctor prepareBeamSpanElements;
     this->Process(prepareBeamSpanElements);
 
-    /************ Match pedal lines ***********/
-
-    PreparePedalsFunctor preparePedals(this);
-    this->Process(preparePedals);
+    logStageTime("beam spans");
 
     /************ Prepare processing by staff/layer/verse ************/
 
@@ -722,7 +764,6 @@ void Doc::PrepareData()
     InitProcessingListsFunctor initProcessingLists;
 
     // We first fill a tree of ints with [staff/layer] and [staff/layer/verse] numbers (@n) to be processed
-    // LogElapsedTimeStart();
     this->Process(initProcessingLists);
     const IntTree &layerTree = initProcessingLists.GetLayerTree();
     const IntTree &verseTree = initProcessingLists.GetVerseTree();
@@ -753,6 +794,8 @@ void Doc::PrepareData()
         }
     }
 
+    logStageTime("pointers by layer");
+
     /************ Resolve delayed turns ************/
 
     PrepareDelayedTurnsFunctor prepareDelayedTurns;
@@ -776,6 +819,8 @@ void Doc::PrepareData()
         }
     }
 
+    logStageTime("delayed turns");
+
     /************ Resolve lyric connectors ************/
 
     // Same for the lyrics, but Verse by Verse since Syl are TimeSpanningInterface elements for handling connectors
@@ -801,6 +846,8 @@ void Doc::PrepareData()
         }
     }
 
+    logStageTime("lyrics");
+
     /************ Fill control event spanning ************/
 
     // Once <slur>, <ties> and @ties are matched but also syl connectors, we need to set them as running
@@ -815,6 +862,8 @@ void Doc::PrepareData()
             prepareStaffCurrentTimeSpanning.GetTimeSpanningElements().size());
     }
 
+    logStageTime("staff current time spanning");
+
     /************ Resolve mRpt ************/
 
     // Process by staff for matching mRpt elements and setting the drawing number
@@ -834,35 +883,28 @@ void Doc::PrepareData()
         }
     }
 
-    /************ Resolve endings ************/
-
-    // Prepare the endings (pointers to the measure after and before the boundaries)
-    PrepareMilestonesFunctor prepareMilestones;
-    this->Process(prepareMilestones);
+    logStageTime("mRpt");
 
-    /************ Resolve floating groups for vertical alignment ************/
+    /************ Resolve endings, floating groups, cue size and @altsym ************/
 
-    // Prepare the floating drawing groups
+    // Prepare the endings (pointers to the measure after and before the boundaries), the floating drawing groups for
+    // vertical alignment, the drawing cue size and match the @altsym references in a single traversal
+    PrepareMilestonesFunctor prepareMilestones;
     PrepareFloatingGrpsFunctor prepareFloatingGrps;
-    this->Process(prepareFloatingGrps);
-
-    /************ Resolve cue size ************/
-
-    // Prepare the drawing cue size
     PrepareCueSizeFunctor prepareCueSize;
-    this->Process(prepareCueSize);
-
-    /************ Resolve @altsym ************/
-
-    // Try to match all pointing elements using @next, @sameas and @stem.sameas
     PrepareAltSymFunctor prepareAltSym;
-    this->Process(prepareAltSym);
+    this->Process({ &prepareMilestones, &prepareFloatingGrps, &prepareCueSize, &prepareAltSym });
+
+    logStageTime("milestones, floating groups and cue size");
 
     /************ Instanciate LayerElement parts (stem, flag, dots, etc) ************/
 
+    // This is kept separate because it adds children that would otherwise be visited by the functors above
     PrepareLayerElementPartsFunctor prepareLayerElementParts;
     this->Process(prepareLayerElementParts);
 
+    logStageTime("layer element parts");
+
     /************ Add default syl for syllables (if applicable) ************/
     ListOfObjects syllables = this->FindAllDescendantsByType(SYLLABLE);
     for (Object *object : syllables) {
@@ -889,7 +931,7 @@ void Doc::PrepareData()
         score->GetScoreDef()->Process(scoreDefSetGrpSym);
     }
 
-    // LogElapsedTimeEnd ("Preparing drawing");
+    logStageTime("syllables, facsimile and group symbols");
 
     m_dataPreparationDone = true;
 }
@@ -900,6 +942,8 @@ void Doc::ScoreDefSetCurrentDoc(bool force)
         return;
     }
 
+    ProfilerStep profilerStep("Doc::ScoreDefSetCurrentDoc");
+
     if (m_currentScoreDefDone) {
         ScoreDefUnsetCurrentFunctor scoreDefUnsetCurrent;
         this->Process(scoreDefUnsetCurrent);
@@ -950,6 +994,8 @@ void Doc::CastOffSmartDoc()
 
 void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
 {
+    ProfilerStep profilerStep("Doc::CastOffDocBase");
+
     Pages *pages = this->GetPages();
     assert(pages);
 
@@ -975,6 +1021,8 @@ void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
         unCastOffPage->LayOutHorizontallyWithCache();
     }
     else {
+        // The aligners need to be reset since the data may have been prepared again (e.g., after editing)
+        unCastOffPage->ResetAligners();
         unCastOffPage->LayOutHorizontallyWithCache(true);
     }
 
@@ -1025,7 +1073,13 @@ void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
     // Here we redo the alignment because of the new scoreDefs
     // Because of the new scoreDef, we need to reset cached drawingX
     castOffSinglePage->ResetCachedDrawingX();
-    castOffSinglePage->LayOutVertically();
+    if (m_options->m_breaksEstimateHeight.GetValue()) {
+        // Pages are laid out vertically only when rendered, so this is enough for breaking them
+        castOffSinglePage->EstimateVerticalLayout();
+    }
+    else {
+        castOffSinglePage->LayOutVertically();
+    }
 
     // Detach the contentPage to prepare for CastOffPages
     pages->DetachChild(0);
@@ -1082,6 +1136,91 @@ void Doc::UnCastOffDoc(bool resetCache)
     m_isCastOff = false;
 }
 
+bool Doc::LayOutDirtyMeasures()
+{
+    if (!this->IsCastOff()) return false;
+
+    Pages *pages = this->GetPages();
+    assert(pages);
+
+    // Find the modified measures for each page
+    std::map<int, std::vector<Measure *>> dirtyMeasures;
+    for (int i = 0; i < pages->GetChildCount(); ++i) {
+        ListOfObjects measures = pages->GetChild(i)->FindAllDescendantsByType(MEASURE, false);
+        for (Object *object : measures) {
+            Measure *measure = vrv_cast<Measure *>(object);
+            assert(measure);
+            if (!measure->IsDirty()) continue;
+            if (!measure->HasCachedHorizontalLayout()) return false;
+            dirtyMeasures[i].push_back(measure);
+        }
+    }
+
+    std::map<Measure *, int> widthShifts;
+    for (auto &[pageIdx, measures] : dirtyMeasures) {
+        Page *page = this->SetDrawingPage(pageIdx);
+        assert(page);
+
+        // Do not use the justification estimated from the cast-off systems, since the layout cached is the one of
+        // the un-cast-off document
+        ListOfObjects systems = page->FindAllDescendantsByType(SYSTEM, false, 1);
+        std::vector<int> castOffTotalWidths;
+        for (Object *object : systems) {
+            System *system = vrv_cast<System *>(object);
+            assert(system);
+            castOffTotalWidths.push_back(system->m_castOffTotalWidth);
+            system->m_castOffTotalWidth = 0;
+        }
+
+        page->LayOutHorizontally();
+
+        auto castOffTotalWidth = castOffTotalWidths.begin();
+        for (Object *object : systems) {
+            vrv_cast<System *>(object)->m_castOffTotalWidth = *(castOffTotalWidth++);
+        }
+
+        // The curve direction of the slurs has to be determined in the un-cast-off document
+        ListOfObjects slurs = page->FindAllDescendantsByType(SLUR);
+        for (Object *object : slurs) {
+            vrv_cast<Slur *>(object)->SetDrawingCurveDir(SlurCurveDirection::None);
+        }
+
+        // Cache the layout of the content of the measures, but not the one of the measures themselves since their
+        // position and width depend on the cast-off system
+        CacheHorizontalLayoutFunctor cacheHorizontalLayout(this);
+        for (Measure *measure : measures) {
+            widthShifts[measure] = measure->UpdateCachedWidth();
+            for (Object *child : measure->GetChildren()) {
+                child->Process(cacheHorizontalLayout);
+            }
+        }
+    }
+
+    // Shift the cached position of the measures following the modified ones, which is relative to the score
+    int shift = 0;
+    for (Object *page : pages->GetChildren()) {
+        for (Object *child : page->GetChildren()) {
+            if (child->Is(SCORE)) {
+                shift = 0;
+                continue;
+            }
+            if (!child->Is(SYSTEM)) continue;
+            for (Object *object : child->GetChildren()) {
+                if (!object->Is(MEASURE)) continue;
+                Measure *measure = vrv_cast<Measure *>(object);
+                assert(measure);
+                if (shift != 0) measure->SetCachedXRel(measure->GetCachedXRel() + shift);
+                if (measure->IsDirty()) {
+                    shift += widthShifts.at(measure);
+                    measure->SetDirty(false);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
 void Doc::CastOffEncodingDoc()
 {
     if (this->IsCastOff()) {
@@ -1125,6 +1264,163 @@ void Doc::CastOffEncodingDoc()
     m_isCastOff = true;
 }
 
+void Doc::GetCastOffLayout(std::vector<CastOffRecord> &layout) const
+{
+    layout.clear();
+
+    if (!this->IsCastOff()) return;
+
+    const Pages *pages = this->GetPages();
+    assert(pages);
+
+    for (const Object *page : pages->GetChildren()) {
+        layout.push_back({ CASTOFF_PAGE, 0, 0, 0 });
+        for (const Object *child : page->GetChildren()) {
+            if (!child->Is(SYSTEM)) {
+                layout.push_back({ CASTOFF_PAGE_CHILD, (uint32_t)child->GetClassId(), 0, 0 });
+                continue;
+            }
+            const System *system = vrv_cast<const System *>(child);
+            assert(system);
+            layout.push_back({ CASTOFF_SYSTEM, 0, system->m_castOffTotalWidth, system->m_castOffJustifiableWidth });
+            for (const Object *systemChild : system->GetChildren()) {
+                layout.push_back({ CASTOFF_SYSTEM_CHILD, (uint32_t)systemChild->GetClassId(), 0, 0 });
+            }
+        }
+    }
+
+    ListOfConstObjects slurs = pages->FindAllDescendantsByType(SLUR, false);
+    for (const Object *object : slurs) {
+        const Slur *slur = vrv_cast<const Slur *>(object);
+        assert(slur);
+        layout.push_back({ CASTOFF_SLUR, (uint32_t)slur->GetDrawingCurveDir(), 0, 0 });
+    }
+}
+
+bool Doc::CastOffLayoutDoc(const std::vector<CastOffRecord> &layout)
+{
+    if (this->IsCastOff()) {
+        LogDebug("Document is already cast off");
+        return false;
+    }
+
+    Pages *pages = this->GetPages();
+    assert(pages);
+
+    this->ScoreDefSetCurrentDoc();
+
+    Page *unCastOffPage = this->SetDrawingPage(0);
+    assert(unCastOffPage);
+
+    // The content to distribute, i.e., the children of the page with the ones of the systems in place of them
+    std::vector<std::pair<Object *, bool>> content;
+    for (Object *child : unCastOffPage->GetChildren()) {
+        if (child->Is(SYSTEM)) {
+            for (Object *systemChild : child->GetChildren()) content.push_back({ systemChild, true });
+        }
+        else {
+            content.push_back({ child, false });
+        }
+    }
+
+    ListOfObjects slurs = unCastOffPage->FindAllDescendantsByType(SLUR, false);
+    ListOfObjects::iterator slurIter = slurs.begin();
+
+    // Check that the layout matches the content before changing anything
+    size_t position = 0;
+    bool hasPage = false;
+    bool hasSystem = false;
+    for (const CastOffRecord &record : layout) {
+        switch (record.m_type) {
+            case CASTOFF_PAGE:
+                hasPage = true;
+                hasSystem = false;
+                break;
+            case CASTOFF_SYSTEM:
+                if (!hasPage) return false;
+                hasSystem = true;
+                break;
+            case CASTOFF_PAGE_CHILD:
+            case CASTOFF_SYSTEM_CHILD: {
+                const bool isSystemChild = (record.m_type == CASTOFF_SYSTEM_CHILD);
+                if (!hasPage || (isSystemChild && !hasSystem)) return false;
+                if (position >= content.size()) return false;
+                if (content.at(position).second != isSystemChild) return false;
+                if (content.at(position).first->GetClassId() != (ClassId)record.m_value) return false;
+                ++position;
+                break;
+            }
+            case CASTOFF_SLUR:
+                if ((slurIter == slurs.end()) || (record.m_value > (uint32_t)SlurCurveDirection::BelowAbove)) {
+                    return false;
+                }
+                ++slurIter;
+                break;
+            default: return false;
+        }
+    }
+    if (!hasPage || (position != content.size()) || (slurIter != slurs.end())) return false;
+
+    // Staff alignments and floating positioners must be reset since the content system aligner will be deleted
+    ResetVerticalAlignmentFunctor resetVerticalAlignment;
+    unCastOffPage->Process(resetVerticalAlignment);
+
+    pages->DetachChild(0);
+    assert(unCastOffPage && !unCastOffPage->GetParent());
+
+    Page *currentPage = NULL;
+    System *currentSystem = NULL;
+    position = 0;
+    slurIter = slurs.begin();
+    for (const CastOffRecord &record : layout) {
+        if (record.m_type == CASTOFF_SLUR) {
+            Slur *slur = vrv_cast<Slur *>(*slurIter);
+            assert(slur);
+            slur->SetDrawingCurveDir((SlurCurveDirection)record.m_value);
+            ++slurIter;
+        }
+        else if (record.m_type == CASTOFF_PAGE) {
+            currentPage = new Page();
+            pages->AddChild(currentPage);
+            currentSystem = NULL;
+        }
+        else if (record.m_type == CASTOFF_SYSTEM) {
+            currentSystem = new System();
+            currentSystem->m_castOffTotalWidth = record.m_totalWidth;
+            currentSystem->m_castOffJustifiableWidth = record.m_justifiableWidth;
+            currentPage->AddChild(currentSystem);
+        }
+        else {
+            // The content page and systems are deleted afterwards - we only give up the ownership
+            Object *object = content.at(position).first;
+            object->GetParent()->Relinquish(object->GetIdx());
+            if (record.m_type == CASTOFF_SYSTEM_CHILD) {
+                currentSystem->AddChild(object);
+            }
+            else {
+                currentPage->AddChild(object);
+            }
+            ++position;
+        }
+    }
+    delete unCastOffPage;
+
+    this->ResetDataPage();
+    this->ScoreDefSetCurrentDoc(true);
+
+    // Optimize the doc if one of the score requires optimization
+    for (Score *score : this->GetVisibleScores()) {
+        if (score->ScoreDefNeedsOptimization(m_options->m_condense.GetValue())) {
+            this->ScoreDefOptimizeDoc();
+            break;
+        }
+    }
+
+    m_isCastOff = true;
+
+    return true;
+}
+
 void Doc::InitSelectionDoc(DocSelection &selection, bool resetCache)
 {
     // No new selection to apply;
@@ -1588,6 +1884,36 @@ void Doc::CollectVisibleScores()
     }
 }
 
+bool Doc::FindByID(const std::string &id, const Object *&element) const
+{
+    const uint64_t revision = Object::GetTreeRevision();
+    if (m_idIndexRevision != revision) {
+        // First lookup since the last modification
+        if (m_idIndexStaleRevision != revision) {
+            m_idIndexStaleRevision = revision;
+            return false;
+        }
+        this->BuildIDIndex();
+        m_idIndexRevision = revision;
+    }
+
+    MapOfStrConstObjects::const_iterator iter = m_idIndex.find(id);
+    if (iter == m_idIndex.end()) {
+        element = NULL;
+        return true;
+    }
+    // NULL is for ids that are not unique
+    element = iter->second;
+    return (element != NULL);
+}
+
+void Doc::BuildIDIndex() const
+{
+    m_idIndex.clear();
+    IndexByIDFunctor indexByID(&m_idIndex, this);
+    this->Process(indexByID, UNLIMITED_DEPTH, true);
+}
+
 int Doc::GetGlyphHeight(char32_t code, int staffSize, bool graceSize) const
 {
     int x, y, w, h;
@@ -1847,23 +2173,23 @@ double Doc::GetCueScaling() const
 
 FontInfo *Doc::GetDrawingSmuflFont(int staffSize, bool graceSize)
 {
-    m_drawingSmuflFont.SetFaceName(this->GetResources().GetCurrentFont().c_str());
+    s_drawingSmuflFont.SetFaceName(this->GetResources().GetCurrentFont().c_str());
     int value = m_drawingSmuflFontSize * staffSize / 100;
     if (graceSize) value = value * m_options->m_graceFactor.GetValue();
-    m_drawingSmuflFont.SetPointSize(value);
-    return &m_drawingSmuflFont;
+    s_drawingSmuflFont.SetPointSize(value);
+    return &s_drawingSmuflFont;
 }
 
 FontInfo *Doc::GetDrawingLyricFont(int staffSize)
 {
-    m_drawingLyricFont.SetPointSize(m_drawingLyricFontSize * staffSize / 100);
-    return &m_drawingLyricFont;
+    s_drawingLyricFont.SetPointSize(m_drawingLyricFontSize * staffSize / 100);
+    return &s_drawingLyricFont;
 }
 
 FontInfo *Doc::GetFingeringFont(int staffSize)
 {
-    m_fingeringFont.SetPointSize(m_fingeringFontSize * staffSize / 100);
-    return &m_fingeringFont;
+    s_fingeringFont.SetPointSize(m_fingeringFontSize * staffSize / 100);
+    return &s_fingeringFont;
 }
 
 double Doc::GetMusicToLyricFontSizeRatio() const
@@ -2128,31 +2454,33 @@ int Doc::CalcMusicFontSize()
     return m_options->m_unit.GetValue() * 8;
 }
 
-int Doc::GetAdjustedDrawingPageHeight() const
+int Doc::GetAdjustedDrawingPageHeight(const Page *page) const
 {
-    assert(m_drawingPage);
+    if (!page) page = m_drawingPage;
+    assert(page);
 
     // Take into account the PPU when getting the page height in facsimile
     if (this->IsTranscription() || this->IsFacs()) {
-        const int factor = DEFINITION_FACTOR / m_drawingPage->GetPPUFactor();
-        return m_drawingPage->m_pageHeight / factor;
+        const int factor = DEFINITION_FACTOR / page->GetPPUFactor();
+        return page->m_pageHeight / factor;
     }
 
-    int contentHeight = m_drawingPage->GetContentHeight();
+    int contentHeight = page->GetContentHeight();
     return (contentHeight + m_drawingPageMarginTop + m_drawingPageMarginBottom) / DEFINITION_FACTOR;
 }
 
-int Doc::GetAdjustedDrawingPageWidth() const
+int Doc::GetAdjustedDrawingPageWidth(const Page *page) const
 {
-    assert(m_drawingPage);
+    if (!page) page = m_drawingPage;
+    assert(page);
 
     // Take into account the PPU when getting the page width in facsimile
     if (this->IsTranscription() || this->IsFacs()) {
-        const int factor = DEFINITION_FACTOR / m_drawingPage->GetPPUFactor();
-        return m_drawingPage->m_pageWidth / factor;
+        const int factor = DEFINITION_FACTOR / page->GetPPUFactor();
+        return page->m_pageWidth / factor;
     }
 
-    int contentWidth = m_drawingPage->GetContentWidth();
+    int contentWidth = page->GetContentWidth();
     return (contentWidth + m_drawingPageMarginLeft + m_drawingPageMarginRight) / DEFINITION_FACTOR;
 }
 
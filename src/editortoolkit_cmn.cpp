@@ -22,6 +22,7 @@
 #include "dynam.h"
 #include "hairpin.h"
 #include "layer.h"
+#include "linkinginterface.h"
 #include "measure.h"
 #include "note.h"
 #include "page.h"
@@ -81,6 +82,13 @@ bool EditorToolkitCMN::ParseEditorAction(const std::string &json_editorAction, b
         }
         return this->Chain(json.get<jsonxx::Array>("param"));
     }
+    else if (action == "batch") {
+        if (!json.has<jsonxx::Array>("param")) {
+            LogError("Incorrectly formatted JSON action");
+            return false;
+        }
+        return this->Batch(json.get<jsonxx::Array>("param"));
+    }
     else if (action == "delete") {
         std::string elementId;
         if (this->ParseDeleteAction(json.get<jsonxx::Object>("param"), elementId)) {
@@ -209,12 +217,107 @@ bool EditorToolkitCMN::Chain(jsonxx::Array actions)
     return status;
 }
 
+bool EditorToolkitCMN::Batch(jsonxx::Array actions)
+{
+    // Parse all the actions before modifying anything
+    std::vector<BatchAction> batchActions;
+    batchActions.reserve(actions.size());
+    for (int i = 0; i < (int)actions.size(); ++i) {
+        if (!actions.has<jsonxx::Object>(i)) {
+            LogError("Incorrectly formatted JSON action %d in the batch", i);
+            return false;
+        }
+        BatchAction batchAction;
+        if (!this->ParseBatchAction(actions.get<jsonxx::Object>(i), batchAction)) {
+            LogError("Could not parse the action %d of the batch", i);
+            return false;
+        }
+        // The batch is committed once at the end
+        if (batchAction.m_action == "commit") continue;
+        batchActions.push_back(batchAction);
+    }
+
+    if (!this->ResolveBatchElements(batchActions)) return false;
+
+    m_isBatch = true;
+    m_chainedId = "";
+    bool status = true;
+    for (int i = 0; i < (int)batchActions.size(); ++i) {
+        BatchAction &batchAction = batchActions.at(i);
+        const bool isInsert = (batchAction.m_action == "insert");
+        std::string targetId = (isInsert) ? batchAction.m_startid : batchAction.m_elementId;
+        if (targetId == CHAINED_ID) targetId = m_chainedId;
+
+        // Keep the content before it gets modified, and the measure for updating the elements resolved in it
+        Object *measure = NULL;
+        Object *target = (targetId.empty()) ? NULL : this->GetBatchElement(targetId);
+        if (target) {
+            if (!this->KeepBatchCopy(target)) {
+                LogError("The content modified by the action %d of the batch cannot be kept", i);
+                status = false;
+                break;
+            }
+            measure = m_batchElements.at(targetId).second;
+        }
+
+        if (!this->ApplyBatchAction(batchAction)) {
+            LogError("The action %d '%s' of the batch failed", i, batchAction.m_action.c_str());
+            status = false;
+            break;
+        }
+        if (measure && (isInsert || (batchAction.m_action == "delete"))) {
+            this->UpdateBatchElements(measure);
+        }
+    }
+
+    this->EndBatch(!status);
+    if (!status) m_chainedId = "";
+    // A single commit for the whole batch
+    m_doc->PrepareData();
+    m_editInfo.import("uuid", m_chainedId);
+
+    return status;
+}
+
+bool EditorToolkitCMN::ParseBatchAction(jsonxx::Object json, BatchAction &batchAction)
+{
+    if (!json.has<jsonxx::String>("action")) return false;
+    batchAction.m_action = json.get<jsonxx::String>("action");
+    if (batchAction.m_action == "commit") return true;
+
+    if (!json.has<jsonxx::Object>("param")) return false;
+    jsonxx::Object param = json.get<jsonxx::Object>("param");
+    if (batchAction.m_action == "delete") {
+        return this->ParseDeleteAction(param, batchAction.m_elementId);
+    }
+    else if (batchAction.m_action == "drag") {
+        return this->ParseDragAction(param, batchAction.m_elementId, batchAction.m_x, batchAction.m_y);
+    }
+    else if (batchAction.m_action == "keyDown") {
+        return this->ParseKeyDownAction(
+            param, batchAction.m_elementId, batchAction.m_key, batchAction.m_shiftKey, batchAction.m_ctrlKey);
+    }
+    else if (batchAction.m_action == "insert") {
+        return this->ParseInsertAction(param, batchAction.m_elementType, batchAction.m_startid, batchAction.m_endid);
+    }
+    else if (batchAction.m_action == "set") {
+        return this->ParseSetAction(param, batchAction.m_elementId, batchAction.m_attribute, batchAction.m_value);
+    }
+    // Chains and nested batches are not supported
+    LogWarning("Unsupported action type '%s' in a batch.", batchAction.m_action.c_str());
+    return false;
+}
+
 bool EditorToolkitCMN::Delete(std::string &elementId)
 {
     Object *element = this->GetElement(elementId);
     if (!element) return false;
     if (element->Is(NOTE)) {
-        return this->DeleteNote(vrv_cast<Note *>(element));
+        // The note and its parent can be deleted
+        Object *layer = element->GetFirstAncestor(LAYER);
+        if (!this->DeleteNote(vrv_cast<Note *>(element))) return false;
+        if (layer) this->SetMeasureDirty(layer);
+        return true;
     }
     return false;
 }
@@ -233,6 +336,7 @@ bool EditorToolkitCMN::Drag(std::string &elementId, int x, int y)
             = (data_PITCHNAME)m_view->CalculatePitchCode(layer, m_view->ToLogicalY(y), element->GetDrawingX(), &oct);
         element->GetPitchInterface()->SetPname(pname);
         element->GetPitchInterface()->SetOct(oct);
+        this->SetMeasureDirty(element);
 
         return true;
     }
@@ -255,6 +359,7 @@ bool EditorToolkitCMN::KeyDown(std::string &elementId, int key, bool shiftKey, b
             default: step = 0;
         }
         interface->AdjustPitchByOffset(step);
+        this->SetMeasureDirty(element);
         return true;
     }
     return false;
@@ -264,8 +369,8 @@ bool EditorToolkitCMN::Insert(std::string &elementType, std::string const &start
 {
     if (!m_doc->GetDrawingPage()) return false;
 
-    Object *start = m_doc->GetDrawingPage()->FindDescendantByID(startid);
-    Object *end = m_doc->GetDrawingPage()->FindDescendantByID(endid);
+    Object *start = this->GetDrawingPageElement(startid);
+    Object *end = this->GetDrawingPageElement(endid);
     // Check if both start and end elements exist
     if (!start || !end) {
         LogInfo("Elements start and end ids '%s' and '%s' could not be found", startid.c_str(), endid.c_str());
@@ -305,6 +410,8 @@ bool EditorToolkitCMN::Insert(std::string &elementType, std::string const &start
     measure->AddChild(element);
     interface->SetStartid("#" + startid);
     interface->SetEndid("#" + endid);
+    this->SetMeasureDirty(element);
+    this->SetMeasureDirty(end);
 
     m_chainedId = element->GetID();
     m_editInfo.import("uuid", element->GetID());
@@ -316,14 +423,18 @@ bool EditorToolkitCMN::Insert(std::string &elementType, std::string const &start
 {
     if (!m_doc->GetDrawingPage()) return false;
 
-    Object *start = m_doc->GetDrawingPage()->FindDescendantByID(startid);
+    Object *start = this->GetDrawingPageElement(startid);
     // Check if both start and end elements exist
     if (!start) {
         LogInfo("Element start id '%s' could not be found", startid.c_str());
         return false;
     }
     if (elementType == "note") {
-        return this->InsertNote(start);
+        // The start element can be replaced
+        Object *layer = start->GetFirstAncestor(LAYER);
+        if (!this->InsertNote(start)) return false;
+        if (layer) this->SetMeasureDirty(layer);
+        return true;
     }
     // Check if it is a LayerElement
     if (!dynamic_cast<LayerElement *>(start)) {
@@ -351,6 +462,7 @@ bool EditorToolkitCMN::Insert(std::string &elementType, std::string const &start
     assert(interface);
     measure->AddChild(element);
     interface->SetStartid("#" + startid);
+    this->SetMeasureDirty(element);
 
     m_chainedId = element->GetID();
     m_editInfo.import("uuid", element->GetID());
@@ -393,6 +505,7 @@ bool EditorToolkitCMN::Set(std::string &elementId, std::string const &attribute,
     else if (AttModule::SetVisual(element, attribute, value))
         success = true;
     if (success) {
+        this->SetMeasureDirty(element);
         return true;
     }
     return false;
@@ -407,6 +520,9 @@ Object *EditorToolkitCMN::GetElement(std::string &elementId)
         m_chainedId = elementId;
     }
 
+    // Use the elements resolved for the batch
+    if (m_isBatch) return this->GetBatchElement(elementId);
+
     Object *element = NULL;
 
     // Try to get the element on the current drawing page
@@ -421,6 +537,213 @@ Object *EditorToolkitCMN::GetElement(std::string &elementId)
     return element;
 }
 
+Object *EditorToolkitCMN::GetDrawingPageElement(const std::string &elementId)
+{
+    Page *page = m_doc->GetDrawingPage();
+    assert(page);
+
+    if (m_isBatch) {
+        Object *element = this->GetBatchElement(elementId);
+        return (element && (element->GetFirstAncestor(PAGE) == page)) ? element : NULL;
+    }
+    return page->FindDescendantByID(elementId);
+}
+
+bool EditorToolkitCMN::ApplyBatchAction(BatchAction &batchAction)
+{
+    if (batchAction.m_action == "delete") {
+        return this->Delete(batchAction.m_elementId);
+    }
+    else if (batchAction.m_action == "drag") {
+        return this->Drag(batchAction.m_elementId, batchAction.m_x, batchAction.m_y);
+    }
+    else if (batchAction.m_action == "keyDown") {
+        return this->KeyDown(batchAction.m_elementId, batchAction.m_key, batchAction.m_shiftKey, batchAction.m_ctrlKey);
+    }
+    else if (batchAction.m_action == "insert") {
+        if (batchAction.m_endid == "") {
+            return this->Insert(batchAction.m_elementType, batchAction.m_startid);
+        }
+        return this->Insert(batchAction.m_elementType, batchAction.m_startid, batchAction.m_endid);
+    }
+    else if (batchAction.m_action == "set") {
+        return this->Set(batchAction.m_elementId, batchAction.m_attribute, batchAction.m_value);
+    }
+    return false;
+}
+
+bool EditorToolkitCMN::ResolveBatchElements(const std::vector<BatchAction> &batchActions)
+{
+    m_batchElements.clear();
+
+    for (const BatchAction &batchAction : batchActions) {
+        for (const std::string &id : { batchAction.m_elementId, batchAction.m_startid, batchAction.m_endid }) {
+            if (id.empty() || (id == CHAINED_ID)) continue;
+            // The document index is valid for all the lookups since nothing has been modified yet
+            if (!this->GetBatchElement(id)) {
+                LogError("Element '%s' of the batch could not be found", id.c_str());
+                m_batchElements.clear();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Object *EditorToolkitCMN::GetBatchElement(const std::string &elementId)
+{
+    auto it = m_batchElements.find(elementId);
+    if (it != m_batchElements.end()) return it->second.first;
+
+    Object *element = m_doc->FindDescendantByID(elementId);
+    if (!element) return NULL;
+    Object *measure = (element->Is(MEASURE)) ? element : element->GetFirstAncestor(MEASURE);
+    m_batchElements[elementId] = { element, measure };
+    return element;
+}
+
+void EditorToolkitCMN::UpdateBatchElements(Object *measure)
+{
+    assert(measure);
+
+    std::set<std::string> ids;
+    for (auto it = m_batchElements.begin(); it != m_batchElements.end();) {
+        if (it->second.second == measure) {
+            ids.insert(it->first);
+            it = m_batchElements.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    if (!m_chainedId.empty()) ids.insert(m_chainedId);
+
+    // Elements not found anymore have been deleted and will be looked for in the whole document if used again
+    ArrayOfObjects objects = { measure };
+    while (!objects.empty() && !ids.empty()) {
+        Object *object = objects.back();
+        objects.pop_back();
+        if (ids.erase(object->GetID())) m_batchElements[object->GetID()] = { object, measure };
+        objects.insert(objects.end(), object->GetChildren().begin(), object->GetChildren().end());
+    }
+}
+
+bool EditorToolkitCMN::KeepBatchCopy(Object *element)
+{
+    assert(element);
+
+    Object *object = (element->Is(MEASURE)) ? element : element->GetFirstAncestor(MEASURE);
+    if (!object) object = (element->Is(SCOREDEF)) ? element : element->GetFirstAncestor(SCOREDEF);
+    if (!object) object = element;
+
+    // Already kept, or within the content kept
+    for (Object *ancestor = object; ancestor; ancestor = ancestor->GetParent()) {
+        if (m_batchCopies.contains(ancestor)) return true;
+    }
+
+    Object *copy = object->Clone();
+    if (!copy) return false;
+    copy->CloneReset();
+    if (!this->CopyIdentity(object, copy)) {
+        delete copy;
+        return false;
+    }
+
+    // Content kept before within the object (outside measures) is put in the copy in its unmodified state
+    if (!object->Is(MEASURE)) {
+        for (auto it = m_batchCopies.begin(); it != m_batchCopies.end();) {
+            Object *ancestor = it->first->GetParent();
+            while (ancestor && (ancestor != object)) ancestor = ancestor->GetParent();
+            if (!ancestor) {
+                ++it;
+                continue;
+            }
+            Object *modified = copy->FindDescendantByID(it->first->GetID());
+            assert(modified && modified->GetParent());
+            modified->GetParent()->ReplaceChild(modified, it->second);
+            delete modified;
+            it = m_batchCopies.erase(it);
+        }
+    }
+
+    m_batchCopies[object] = copy;
+    return true;
+}
+
+bool EditorToolkitCMN::CopyIdentity(Object *source, Object *target)
+{
+    assert(source && target);
+
+    target->SetID(source->GetID());
+    target->SetComment(source->GetComment());
+    target->SetClosingComment(source->GetClosingComment());
+    // Copying objects sets a link to the original one
+    LinkingInterface *linking = target->GetLinkingInterface();
+    if (linking) {
+        assert(source->GetLinkingInterface());
+        linking->SetCorresp(source->GetLinkingInterface()->GetCorresp());
+    }
+
+    // Children created when preparing the data (e.g., tuplet brackets) are not copied and are created again
+    const ArrayOfObjects &targetChildren = target->GetChildren();
+    auto targetChild = targetChildren.begin();
+    for (Object *sourceChild : source->GetChildren()) {
+        if ((targetChild == targetChildren.end()) || ((*targetChild)->GetClassId() != sourceChild->GetClassId())) {
+            if (!sourceChild->Is({ TUPLET_BRACKET, TUPLET_NUM })) return false;
+            continue;
+        }
+        if (!this->CopyIdentity(sourceChild, *targetChild)) return false;
+        ++targetChild;
+    }
+    return (targetChild == targetChildren.end());
+}
+
+void EditorToolkitCMN::EndBatch(bool rollback)
+{
+    for (auto &[object, copy] : m_batchCopies) {
+        if (!rollback) {
+            delete copy;
+            continue;
+        }
+        Object *parent = object->GetParent();
+        assert(parent);
+        parent->ReplaceChild(object, copy);
+        delete object;
+        this->SetMeasureDirty(copy);
+        // The drawing data of the copy is not set, so the layout of the whole document has to be redone
+        if (copy->Is(MEASURE)) vrv_cast<Measure *>(copy)->ResetCachedWidth();
+    }
+    m_batchCopies.clear();
+    m_batchElements.clear();
+    m_isBatch = false;
+}
+
+void EditorToolkitCMN::SetMeasureDirty(Object *object)
+{
+    assert(object);
+
+    Measure *measure = vrv_cast<Measure *>(object->Is(MEASURE) ? object : object->GetFirstAncestor(MEASURE));
+    if (!measure) {
+        // Elements outside measures (e.g., scoreDef) can change all of them, so the cache cannot be used anymore
+        ListOfObjects measures = m_doc->FindAllDescendantsByType(MEASURE, false);
+        for (Object *child : measures) {
+            Measure *documentMeasure = vrv_cast<Measure *>(child);
+            assert(documentMeasure);
+            documentMeasure->SetDirty(true);
+            documentMeasure->ResetCachedWidth();
+        }
+        return;
+    }
+    measure->SetDirty(true);
+
+    if (object->HasInterface(INTERFACE_TIME_SPANNING)) {
+        LayerElement *end = object->GetTimeSpanningInterface()->GetEnd();
+        if (end && end->GetFirstAncestor(MEASURE)) {
+            vrv_cast<Measure *>(end->GetFirstAncestor(MEASURE))->SetDirty(true);
+        }
+    }
+}
+
 bool EditorToolkitCMN::InsertNote(Object *object)
 {
     assert(object);
@@ -154,7 +154,14 @@ void FeatureExtractor::Extract(const Object *object)
 void FeatureExtractor::ToJson(std::string &output)
 {
     jsonxx::Object o;
+    this->ToJson(o);
 
+    output = o.json();
+    LogDebug("%s", output.c_str());
+}
+
+void FeatureExtractor::ToJson(jsonxx::Object &o)
+{
     o << "pitchesChromaticWithDuration" << m_pitchesChromaticWithDuration;
     o << "pitchesChromatic" << m_pitchesChromatic;
     o << "pitchesDiatonic" << m_pitchesDiatonic;
@@ -165,9 +172,6 @@ void FeatureExtractor::ToJson(std::string &output)
     o << "intervalGrossContour" << m_intervalGrossContour;
     o << "intervalRefinedContour" << m_intervalRefinedContour;
     o << "intervalsIds" << m_intervalsIds;
-
-    output = o.json();
-    LogDebug("%s", output.c_str());
 }
 
 } // namespace vrv
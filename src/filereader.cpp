@@ -11,6 +11,14 @@
 
 #include <fstream>
 
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VRV_USE_MMAP
+#endif
+
 //----------------------------------------------------------------------------
 
 #include "vrv.h"
@@ -21,6 +29,110 @@
 
 namespace vrv {
 
+//----------------------------------------------------------------------------
+// MemoryMappedFile
+//----------------------------------------------------------------------------
+
+MemoryMappedFile::MemoryMappedFile()
+{
+    m_data = NULL;
+    m_size = 0;
+    m_isMapped = false;
+    m_isOpen = false;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    this->Close();
+}
+
+void MemoryMappedFile::Close()
+{
+#ifdef VRV_USE_MMAP
+    if (m_isMapped) {
+        munmap(const_cast<char *>(m_data), m_size);
+    }
+#endif
+    m_data = NULL;
+    m_size = 0;
+    m_isMapped = false;
+    m_isOpen = false;
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+}
+
+bool MemoryMappedFile::Open(const std::string &filename)
+{
+    this->Close();
+
+#ifdef VRV_USE_MMAP
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) == -1) || !S_ISREG(fileStat.st_mode)) {
+        // Not a regular file (e.g., a pipe) - read it instead
+        close(fd);
+        return this->ReadIntoBuffer(filename);
+    }
+
+    m_size = (size_t)fileStat.st_size;
+    // mmap does not support empty mappings
+    if (m_size == 0) {
+        close(fd);
+        m_data = "";
+        m_isOpen = true;
+        return true;
+    }
+
+    void *mapped = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        m_size = 0;
+        return this->ReadIntoBuffer(filename);
+    }
+    // The importers go through the content from the beginning to the end
+    madvise(mapped, m_size, MADV_SEQUENTIAL);
+
+    m_data = static_cast<const char *>(mapped);
+    m_isMapped = true;
+    m_isOpen = true;
+    return true;
+#else
+    return this->ReadIntoBuffer(filename);
+#endif
+}
+
+bool MemoryMappedFile::ReadIntoBuffer(const std::string &filename)
+{
+    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!fin.is_open()) {
+        return false;
+    }
+
+    fin.seekg(0, std::ios::end);
+    std::streamsize fileSize = (std::streamsize)fin.tellg();
+    fin.clear();
+    fin.seekg(0, std::ios::beg);
+
+    if (fileSize > 0) {
+        m_buffer.resize(fileSize);
+        fin.read(&m_buffer[0], fileSize);
+        m_buffer.resize(fin.gcount());
+    }
+    else {
+        // Size unknown - read until the end
+        m_buffer.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+    }
+
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    m_isOpen = true;
+    return true;
+}
+
 //----------------------------------------------------------------------------
 // ZipFileReader
 //----------------------------------------------------------------------------
@@ -56,33 +168,25 @@ bool ZipFileReader::Load(const std::string &filename)
     std::vector<unsigned char> bytes = Base64Decode(data);
     return this->LoadBytes(bytes);
 #else
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
+    MemoryMappedFile file;
+    if (!file.Open(filename)) {
         LogError("File archive '%s' could not be opened.", filename.c_str());
         return false;
     }
-
-    fin.seekg(0, std::ios::end);
-    std::streamsize fileSize = (std::streamsize)fin.tellg();
-    fin.clear();
-    fin.seekg(0, std::wios::beg);
-
-    std::vector<unsigned char> bytes;
-    bytes.reserve(fileSize + 1);
-
-    unsigned char buffer;
-    while (fin.read((char *)&buffer, sizeof(unsigned char))) {
-        bytes.push_back(buffer);
-    }
-    return this->LoadBytes(bytes);
+    return this->LoadBuffer(file.GetBytes(), file.GetSize());
 #endif
 }
 
 bool ZipFileReader::LoadBytes(const std::vector<unsigned char> &bytes)
+{
+    return this->LoadBuffer(bytes.data(), bytes.size());
+}
+
+bool ZipFileReader::LoadBuffer(const unsigned char *data, size_t length)
 {
     this->Reset();
 
-    m_file = new miniz_cpp::zip_file(bytes);
+    m_file = new miniz_cpp::zip_file(data, length);
 
     return true;
 }
@@ -167,6 +167,37 @@ FunctorCode FindByIDFunctor::VisitObject(const Object *object)
     return FUNCTOR_CONTINUE;
 }
 
+//----------------------------------------------------------------------------
+// IndexByIDFunctor
+//----------------------------------------------------------------------------
+
+IndexByIDFunctor::IndexByIDFunctor(MapOfStrConstObjects *index, const Object *root) : ConstFunctor()
+{
+    m_index = index;
+    m_ancestors.push_back(root);
+    // Hidden elements are indexed too - visibility is checked when looking up
+    this->SetVisibleOnly(false);
+}
+
+FunctorCode IndexByIDFunctor::VisitObject(const Object *object)
+{
+    // An object not visited from its parent is a child of a reference object
+    const bool isOwned = (object->GetParent() == m_ancestors.back());
+    m_ancestors.push_back(object);
+
+    auto [iter, inserted] = m_index->try_emplace(object->GetID(), object);
+    if (!inserted || !isOwned) iter->second = NULL;
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode IndexByIDFunctor::VisitObjectEnd(const Object *object)
+{
+    m_ancestors.pop_back();
+
+    return FUNCTOR_CONTINUE;
+}
+
 //----------------------------------------------------------------------------
 // FindNextChildByComparisonFunctor
 //----------------------------------------------------------------------------
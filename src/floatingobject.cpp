@@ -444,6 +444,20 @@ int FloatingPositioner::GetAdmissibleHorizOverlapMargin(const BoundingBox *bbox,
     return 0;
 }
 
+std::pair<int, int> FloatingPositioner::GetHorizontalOverlapRange(int unit) const
+{
+    // The largest margin GetAdmissibleHorizOverlapMargin can return
+    int margin = 0;
+    if (this->GetObject()->IsExtenderElement()) {
+        margin = 8 * unit;
+    }
+    else if (this->GetObject()->Is(DYNAM)) {
+        margin = 2 * unit;
+    }
+
+    return { this->GetContentLeft() - margin, this->GetContentRight() + m_drawingExtenderWidth + margin };
+}
+
 void FloatingPositioner::CalcDrawingYRel(
     const Doc *doc, const StaffAlignment *staffAlignment, const BoundingBox *horizOverlappingBBox)
 {
@@ -52,6 +52,15 @@ void FTrem::Reset()
     this->ResetTremMeasured();
 }
 
+void FTrem::CloneReset()
+{
+    // Since these are owned by the fTrem we cloned from, empty the list
+    // Do it before Object::CloneReset since that one will reset the coord list
+    m_beamElementCoords.clear();
+
+    LayerElement::CloneReset();
+}
+
 bool FTrem::IsSupportedChild(Object *child)
 {
     if (child->Is(CHORD)) {
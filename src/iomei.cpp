@@ -3397,12 +3397,18 @@ MEIInput::MEIInput(Doc *doc) : Input(doc)
 MEIInput::~MEIInput() {}
 
 bool MEIInput::Import(const std::string &mei)
+{
+    return this->ImportBuffer(mei);
+}
+
+bool MEIInput::ImportBuffer(std::string_view mei)
 {
     try {
         m_doc->Reset();
         m_doc->SetType(Raw);
         pugi::xml_document doc;
-        doc.load_string(mei.c_str(), (pugi::parse_comments | pugi::parse_default) & ~pugi::parse_eol);
+        doc.load_buffer(mei.data(), mei.size(), (pugi::parse_comments | pugi::parse_default) & ~pugi::parse_eol,
+            pugi::encoding_utf8);
         pugi::xml_node root = doc.first_child();
         return this->ReadDoc(root);
     }
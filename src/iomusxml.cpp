@@ -120,12 +120,17 @@ MusicXmlInput::~MusicXmlInput()
 #ifndef NO_MUSICXML_SUPPORT
 
 bool MusicXmlInput::Import(const std::string &musicxml)
+{
+    return this->ImportBuffer(musicxml);
+}
+
+bool MusicXmlInput::ImportBuffer(std::string_view musicxml)
 {
     try {
         m_doc->Reset();
         m_doc->SetType(Raw);
         pugi::xml_document xmlDoc;
-        xmlDoc.load_string(musicxml.c_str());
+        xmlDoc.load_buffer(musicxml.data(), musicxml.size(), pugi::parse_default, pugi::encoding_utf8);
         pugi::xml_node root = xmlDoc.first_child();
         return ReadMusicXml(root);
     }
@@ -629,64 +629,83 @@ std::string escape_string( const std::string &input, const bool quote = false )
 
 namespace json {
 
-    std::string remove_last_comma( const std::string &_input ) {
-        std::string input( _input );
+    void remove_last_comma( std::string &input ) {
         size_t size = input.size();
         if( size > 2 )
             if( input[ size - 2 ] == ',' )
                 input[ size - 2 ] = ' ';
-        return input;
     }
 
-    std::string tag( unsigned format, unsigned depth, const std::string &name, const jsonxx::Value &t) {
-        std::stringstream ss;
-        const std::string tab(depth, '\t');
+    // Append the value to the output instead of building and concatenating a string for each level (lpugin)
+    void tag( std::string &output, std::ostringstream &number, unsigned depth, const std::string &name, const jsonxx::Value &t) {
+        output.append( depth, '\t' );
 
-        if( !name.empty() )
-            ss << tab << '\"' << escape_string( name ) << '\"' << ':' << ' ';
-        else
-            ss << tab;
+        if( !name.empty() ) {
+            output += '\"';
+            output += escape_string( name );
+            output += "\": ";
+        }
 
         switch( t.type_ )
         {
             default:
             case jsonxx::Value::NULL_:
-                ss << "null";
-                return ss.str() + ",\n";
+                output += "null";
+                break;
 
             case jsonxx::Value::BOOL_:
-                ss << ( t.bool_value_ ? "true" : "false" );
-                return ss.str() + ",\n";
+                output += ( t.bool_value_ ? "true" : "false" );
+                break;
 
             case jsonxx::Value::ARRAY_:
-                ss << "[\n";
+                output += "[\n";
                 for(Array::container::const_iterator it = t.array_value_->values().begin(),
                     end = t.array_value_->values().end(); it != end; ++it )
-                  ss << tag( format, depth+1, std::string(), **it );
-                return remove_last_comma( ss.str() ) + tab + "]" ",\n";
+                  tag( output, number, depth+1, std::string(), **it );
+                remove_last_comma( output );
+                output.append( depth, '\t' );
+                output += ']';
+                break;
 
             case jsonxx::Value::STRING_:
-                ss << '\"' << escape_string( *t.string_value_ ) << '\"';
-                return ss.str() + ",\n";
+                output += '\"';
+                output += escape_string( *t.string_value_ );
+                output += '\"';
+                break;
 
             case jsonxx::Value::OBJECT_:
-                ss << "{\n";
+                output += "{\n";
                 for(Object::container::const_iterator it=t.object_value_->kv_map().begin(),
                     end = t.object_value_->kv_map().end(); it != end ; ++it)
-                  ss << tag( format, depth+1, it->first, *it->second );
-                return remove_last_comma( ss.str() ) + tab + "}" ",\n";
+                  tag( output, number, depth+1, it->first, *it->second );
+                remove_last_comma( output );
+                output.append( depth, '\t' );
+                output += '}';
+                break;
 
             case jsonxx::Value::NUMBER_:
+                // The stream is reused for all the numbers
+                number.str( std::string() );
+                number.unsetf( std::ios_base::floatfield );
                 // controlled (lpugin) precision
                 if (t.precision_ != -1) {
-                    ss << std::setprecision(t.precision_) << std::fixed;
+                    number << std::setprecision(t.precision_) << std::fixed;
                 }
                 else {
-                    ss << std::setprecision(std::numeric_limits<long double>::digits10 + 1);
+                    number << std::setprecision(std::numeric_limits<long double>::digits10 + 1);
                 }
-                ss << t.number_value_;
-                return ss.str() + ",\n";
+                number << t.number_value_;
+                output += number.str();
+                break;
         }
+        output += ",\n";
+    }
+
+    std::string tag( const jsonxx::Value &t ) {
+        std::string output;
+        std::ostringstream number;
+        tag( output, number, 0, std::string(), t );
+        return output;
     }
 } // namespace jsonxx::anon::json
 
@@ -927,10 +946,11 @@ std::string Object::json() const {
     v.object_value_ = const_cast<jsonxx::Object*>(this);
     v.type_ = jsonxx::Value::OBJECT_;
 
-    std::string result = tag( jsonxx::JSON, 0, std::string(), v );
+    std::string result = tag( v );
 
     v.object_value_ = 0;
-    return remove_last_comma( result );
+    remove_last_comma( result );
+    return result;
 }
 
 std::string Object::xml( unsigned format, const std::string &header, const std::string &attrib ) const {
@@ -954,10 +974,11 @@ std::string Array::json() const {
     v.array_value_ = const_cast<jsonxx::Array*>(this);
     v.type_ = jsonxx::Value::ARRAY_;
 
-    std::string result = tag( jsonxx::JSON, 0, std::string(), v );
+    std::string result = tag( v );
 
     v.array_value_ = 0;
-    return remove_last_comma( result );
+    remove_last_comma( result );
+    return result;
 }
 
 std::string Array::xml( unsigned format, const std::string &header, const std::string &attrib ) const {
@@ -1070,6 +1091,18 @@ std::string xml( const std::string &input, unsigned format ) {
 Object::Object(const Object &other) {
   import(other);
 }
+// move the values instead of copying them (lpugin)
+Object::Object(Object &&other) {
+  value_map_.swap(other.value_map_);
+}
+Object &Object::operator=(Object &&other) {
+  odd.clear();
+  if (this != &other) {
+    reset();
+    value_map_.swap(other.value_map_);
+  }
+  return *this;
+}
 Object::Object(const std::string &key, const Value &value) {
   import(key,value);
 }
@@ -1112,8 +1145,10 @@ Object &Object::operator<<(const Value &value) {
   if (odd.empty()) {
     odd = value.get<String>();
   } else {
-    import( Object(odd, value) );
-    odd.clear();
+    // import directly instead of copying the value through a temporary object (lpugin)
+    std::string key;
+    key.swap( odd );
+    import( key, value );
   }
   return *this;
 }
@@ -1153,6 +1188,17 @@ bool Object::parse(const std::string &input) {
 Array::Array(const Array &other) {
   import(other);
 }
+// move the values instead of copying them (lpugin)
+Array::Array(Array &&other) {
+  values_.swap(other.values_);
+}
+Array &Array::operator=(Array &&other) {
+  if( this != &other ) {
+    reset();
+    values_.swap(other.values_);
+  }
+  return *this;
+}
 Array::Array(const Value &value) {
   import(value);
 }
@@ -268,7 +268,9 @@ int LayerElement::GetOriginalLayerN() const
 {
     int layerN = this->GetAlignmentLayerN();
     if (layerN < 0) {
-        layerN = vrv_cast<const Layer *>(this->GetFirstAncestor(LAYER))->GetN();
+        // Timestamps are not in a layer and use 0, as when they are aligned (see Alignment::AddLayerElementRef)
+        const Layer *layer = vrv_cast<const Layer *>(this->GetFirstAncestor(LAYER));
+        layerN = (layer) ? layer->GetN() : 0;
     }
     return layerN;
 }
@@ -144,6 +144,8 @@ void Measure::Reset()
     m_cachedXRel = VRV_UNSET;
     m_cachedOverflow = VRV_UNSET;
     m_cachedWidth = VRV_UNSET;
+    m_cachedJustifiableWidth = VRV_UNSET;
+    m_isDirty = false;
 
     // by default, we have a single barLine on the right (none on the left)
     m_rightBarLine.SetForm(this->GetRight());
@@ -240,6 +242,7 @@ void Measure::CacheXRel(bool restore)
     }
     else {
         m_cachedWidth = this->GetWidth();
+        m_cachedJustifiableWidth = this->GetRightBarLineXRel() - this->GetLeftBarLineXRel();
         m_cachedOverflow = this->GetDrawingOverflow();
         m_cachedXRel = m_drawingXRel;
     }
@@ -359,6 +362,19 @@ int Measure::GetInnerCenterX() const
     return (this->GetDrawingX() + this->GetLeftBarLineRight() + this->GetInnerWidth() / 2);
 }
 
+int Measure::UpdateCachedWidth()
+{
+    assert(this->HasCachedHorizontalLayout());
+
+    const int justifiableWidth = this->GetRightBarLineXRel() - this->GetLeftBarLineXRel();
+    const int shift = justifiableWidth - m_cachedJustifiableWidth;
+    m_cachedWidth += shift;
+    m_cachedJustifiableWidth = justifiableWidth;
+    m_cachedOverflow = this->GetDrawingOverflow();
+
+    return shift;
+}
+
 int Measure::GetDrawingOverflow()
 {
     AdjustXOverflowFunctor adjustXOverflow(0);
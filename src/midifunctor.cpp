@@ -357,6 +357,18 @@ GenerateMIDIFunctor::GenerateMIDIFunctor(smf::MidiFile *midiFile) : ConstFunctor
     m_lastNote = NULL;
     m_accentedGraceNote = false;
     m_cueExclusion = false;
+    m_currentLayer = -1;
+}
+
+void GenerateMIDIFunctor::AddLayer(int staffN, int layerN, int track, int channel, int transSemi)
+{
+    MIDILayer layer;
+    layer.m_staffN = staffN;
+    layer.m_layerN = layerN;
+    layer.m_midiTrack = track;
+    layer.m_midiChannel = channel;
+    layer.m_transSemi = transSemi;
+    m_layers.push_back(layer);
 }
 
 FunctorCode GenerateMIDIFunctor::VisitBeatRpt(const BeatRpt *beatRpt)
@@ -475,6 +487,35 @@ FunctorCode GenerateMIDIFunctor::VisitChord(const Chord *chord)
     return FUNCTOR_CONTINUE;
 }
 
+FunctorCode GenerateMIDIFunctor::VisitDoc(const Doc *doc)
+{
+    // Events are collected in temporary tracks added after the MIDI tracks
+    for (MIDILayer &layer : m_layers) {
+        layer.m_eventTrack = m_midiFile->addTrack();
+    }
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode GenerateMIDIFunctor::VisitDocEnd(const Doc *doc)
+{
+    if (m_layers.empty()) return FUNCTOR_CONTINUE;
+
+    for (MIDILayer &layer : m_layers) {
+        smf::MidiEventList &events = (*m_midiFile)[layer.m_eventTrack];
+        for (int i = 0; i < events.size(); ++i) {
+            m_midiFile->addEvent(layer.m_midiTrack, events[i]);
+        }
+    }
+
+    // Remove the temporary tracks, which are the last ones
+    for (auto layer = m_layers.rbegin(); layer != m_layers.rend(); ++layer) {
+        m_midiFile->deleteTrack(layer->m_eventTrack);
+    }
+
+    return FUNCTOR_CONTINUE;
+}
+
 FunctorCode GenerateMIDIFunctor::VisitFTrem(const FTrem *fTrem)
 {
     if (fTrem->HasUnitdur()) {
@@ -525,6 +566,23 @@ FunctorCode GenerateMIDIFunctor::VisitLayer(const Layer *layer)
 {
     if ((layer->GetCue() == BOOLEAN_true) && m_cueExclusion) return FUNCTOR_SIBLINGS;
 
+    if (m_layers.empty()) return FUNCTOR_CONTINUE;
+
+    const int layerN = layer->GetN();
+    auto iter = std::find_if(m_layers.begin(), m_layers.end(), [this, layerN](const MIDILayer &midiLayer) {
+        return ((midiLayer.m_staffN == m_staffN) && (midiLayer.m_layerN == layerN));
+    });
+    if (iter == m_layers.end()) return FUNCTOR_SIBLINGS;
+
+    // Restore the state of the layer
+    m_currentLayer = (int)std::distance(m_layers.begin(), iter);
+    m_midiTrack = iter->m_eventTrack;
+    m_midiChannel = iter->m_midiChannel;
+    m_transSemi = iter->m_transSemi;
+    m_lastNote = iter->m_lastNote;
+    m_graceNotes = std::move(iter->m_graceNotes);
+    m_accentedGraceNote = iter->m_accentedGraceNote;
+
     return FUNCTOR_CONTINUE;
 }
 
@@ -539,6 +597,16 @@ FunctorCode GenerateMIDIFunctor::VisitLayerEnd(const Layer *layer)
 
     m_heldNotes.clear();
 
+    // Save the state of the layer for its next measure
+    if (m_currentLayer != -1) {
+        MIDILayer &midiLayer = m_layers.at(m_currentLayer);
+        midiLayer.m_lastNote = m_lastNote;
+        midiLayer.m_graceNotes = std::move(m_graceNotes);
+        midiLayer.m_accentedGraceNote = m_accentedGraceNote;
+        m_graceNotes.clear();
+        m_currentLayer = -1;
+    }
+
     return FUNCTOR_CONTINUE;
 }
 
@@ -698,25 +766,48 @@ FunctorCode GenerateMIDIFunctor::VisitPedal(const Pedal *pedal)
 {
     if (!pedal->HasDir()) return FUNCTOR_CONTINUE;
 
+    // Pedals are not limited to a staff and go to every track
+    if (m_layers.empty()) {
+        this->GeneratePedalMIDI(pedal, m_midiTrack, m_midiChannel);
+    }
+    for (const MIDILayer &layer : m_layers) {
+        this->GeneratePedalMIDI(pedal, layer.m_eventTrack, layer.m_midiChannel);
+    }
+
+    return FUNCTOR_CONTINUE;
+}
+
+void GenerateMIDIFunctor::GeneratePedalMIDI(const Pedal *pedal, int track, int channel)
+{
     double pedalTime = pedal->GetStart()->GetAlignment()->GetTime() * static_cast<int>(DURATION_4) / DUR_MAX;
     double startTime = m_totalTime + pedalTime;
     int tpq = m_midiFile->getTPQ();
 
     // todo: check pedal @func to switch between sustain/soften/damper pedals?
     switch (pedal->GetDir()) {
-        case pedalLog_DIR_down: m_midiFile->addSustainPedalOn(m_midiTrack, (startTime * tpq), m_midiChannel); break;
-        case pedalLog_DIR_up: m_midiFile->addSustainPedalOff(m_midiTrack, (startTime * tpq), m_midiChannel); break;
+        case pedalLog_DIR_down: m_midiFile->addSustainPedalOn(track, (startTime * tpq), channel); break;
+        case pedalLog_DIR_up: m_midiFile->addSustainPedalOff(track, (startTime * tpq), channel); break;
         case pedalLog_DIR_bounce:
-            m_midiFile->addSustainPedalOff(m_midiTrack, (startTime * tpq), m_midiChannel);
-            m_midiFile->addSustainPedalOn(m_midiTrack, (startTime * tpq) + 0.1, m_midiChannel);
+            m_midiFile->addSustainPedalOff(track, (startTime * tpq), channel);
+            m_midiFile->addSustainPedalOn(track, (startTime * tpq) + 0.1, channel);
             break;
-        default: return FUNCTOR_CONTINUE;
+        default: break;
+    }
+}
+
+FunctorCode GenerateMIDIFunctor::VisitScoreDef(const ScoreDef *scoreDef)
+{
+    if (m_layers.empty()) {
+        this->GenerateScoreDefMIDI(scoreDef, m_midiTrack);
+    }
+    for (const MIDILayer &layer : m_layers) {
+        this->GenerateScoreDefMIDI(scoreDef, layer.m_eventTrack);
     }
 
     return FUNCTOR_CONTINUE;
 }
 
-FunctorCode GenerateMIDIFunctor::VisitScoreDef(const ScoreDef *scoreDef)
+void GenerateMIDIFunctor::GenerateScoreDefMIDI(const ScoreDef *scoreDef, int track)
 {
     double totalTime = m_totalTime;
     // check next measure for the time offset
@@ -746,7 +837,7 @@ FunctorCode GenerateMIDIFunctor::VisitScoreDef(const ScoreDef *scoreDef)
             case TEMPERAMENT_pythagorean: midiEvent.makeTemperamentPythagorean(referencePitchClass); break;
             default: break;
         }
-        m_midiFile->addEvent(m_midiTrack, midiEvent);
+        m_midiFile->addEvent(track, midiEvent);
     }
     // set tuning
     if (scoreDef->HasTuneHz()) {
@@ -758,39 +849,40 @@ FunctorCode GenerateMIDIFunctor::VisitScoreDef(const ScoreDef *scoreDef)
             tuneFrequencies.push_back(std::make_pair(i, freq));
         }
         midiEvent.makeMts2_KeyTuningsByFrequency(tuneFrequencies);
-        m_midiFile->addEvent(m_midiTrack, midiEvent);
+        m_midiFile->addEvent(track, midiEvent);
     }
     // set MIDI key signature
     if (scoreDef->HasKeySigInfo()) {
         const KeySig *keySig = vrv_cast<const KeySig *>(scoreDef->GetKeySig());
         if (keySig && keySig->HasSig()) {
             // m_midiFile->addKeySignature(
-            //     m_midiTrack, currentTick, keySig->GetFifthsInt(), (keySig->GetMode() == MODE_minor));
+            //     track, currentTick, keySig->GetFifthsInt(), (keySig->GetMode() == MODE_minor));
         }
     }
     // set MIDI time signature
     if (scoreDef->HasMeterSigInfo()) {
         const MeterSig *meterSig = vrv_cast<const MeterSig *>(scoreDef->GetMeterSig());
         if (meterSig && meterSig->HasCount() && meterSig->HasUnit()) {
-            m_midiFile->addTimeSignature(m_midiTrack, currentTick, meterSig->GetTotalCount(), meterSig->GetUnit());
+            m_midiFile->addTimeSignature(track, currentTick, meterSig->GetTotalCount(), meterSig->GetUnit());
         }
     }
-
-    return FUNCTOR_CONTINUE;
 }
 
 FunctorCode GenerateMIDIFunctor::VisitStaff(const Staff *staff)
 {
     m_expandedNotes.clear();
+    m_staffN = staff->GetN();
 
     return FUNCTOR_CONTINUE;
 }
 
 FunctorCode GenerateMIDIFunctor::VisitStaffDef(const StaffDef *staffDef)
 {
-    if (staffDef->GetN() == m_staffN) {
-        // Update the semitone transposition
-        if (staffDef->HasTransSemi()) m_transSemi = staffDef->GetTransSemi();
+    // Update the semitone transposition of the layers of the staff
+    if (staffDef->HasTransSemi()) {
+        for (MIDILayer &layer : m_layers) {
+            if (layer.m_staffN == staffDef->GetN()) layer.m_transSemi = staffDef->GetTransSemi();
+        }
     }
 
     return FUNCTOR_CONTINUE;
@@ -39,8 +39,10 @@
 #include "miscfunctor.h"
 #include "nc.h"
 #include "note.h"
+#include "objectarena.h"
 #include "page.h"
 #include "plistinterface.h"
+#include "profiler.h"
 #include "resetfunctor.h"
 #include "savefunctor.h"
 #include "score.h"
@@ -67,6 +69,7 @@ namespace vrv {
 
 thread_local unsigned long Object::s_objectCounter = 0;
 thread_local uint32_t Object::s_xmlIDCounter = 0;
+std::atomic<uint64_t> Object::s_treeRevision = 0;
 
 Object::Object() : BoundingBox()
 {
@@ -163,6 +166,7 @@ Object &Object::operator=(const Object &object)
         m_interfaces = object.m_interfaces;
         // New id
         this->GenerateID();
+        IncrementTreeRevision();
         // For now do now copy them
         m_unsupported = object.m_unsupported;
         LinkingInterface *link = this->GetLinkingInterface();
@@ -189,6 +193,16 @@ Object::~Object()
     ClearChildren();
 }
 
+void *Object::operator new(std::size_t size)
+{
+    return ObjectArena::Allocate(size);
+}
+
+void Object::operator delete(void *ptr)
+{
+    ObjectArena::Deallocate(ptr);
+}
+
 void Object::Init(ClassId classId, const std::string &classIdStr)
 {
     assert(classIdStr.size());
@@ -337,6 +351,7 @@ void Object::InsertAfter(Object *child, Object *newChild)
 void Object::SortChildren(Object::binaryComp comp)
 {
     std::stable_sort(m_children.begin(), m_children.end(), comp);
+    IncrementTreeRevision();
     this->Modify();
 }
 
@@ -361,6 +376,9 @@ void Object::SwapID(Object *other)
 
 void Object::ClearChildren()
 {
+    // Objects without children are removed from a tree through their parent
+    if (!m_children.empty()) IncrementTreeRevision();
+
     if (m_isReferenceObject) {
         m_children.clear();
         return;
@@ -571,6 +589,8 @@ Object *Object::Relinquish(int idx)
 
 void Object::ClearRelinquishedChildren()
 {
+    IncrementTreeRevision();
+
     ArrayOfObjects::iterator iter;
     for (iter = m_children.begin(); iter != m_children.end();) {
         if ((*iter)->GetParent() != this) {
@@ -589,6 +609,27 @@ Object *Object::FindDescendantByID(const std::string &id, int deepness, bool dir
 
 const Object *Object::FindDescendantByID(const std::string &id, int deepness, bool direction) const
 {
+    // Use the id index of the document for unlimited forward lookups
+    if ((deepness == UNLIMITED_DEPTH) && (direction == FORWARD)) {
+        const Object *root = this;
+        while (root->m_parent) root = root->m_parent;
+        if (root->Is(DOC)) {
+            const Doc *doc = vrv_cast<const Doc *>(root);
+            assert(doc);
+            const Object *element = NULL;
+            if (doc->FindByID(id, element)) {
+                if (!element) return NULL;
+                // The element has to be a descendant not within a hidden ancestor
+                const Object *ancestor = element->m_parent;
+                while (ancestor && !ancestor->SkipChildren(true)) {
+                    if (ancestor == this) return element;
+                    ancestor = ancestor->m_parent;
+                }
+                return NULL;
+            }
+        }
+    }
+
     FindByIDFunctor findByID(id);
     findByID.SetDirection(direction);
     this->Process(findByID, deepness, true);
@@ -739,6 +780,7 @@ bool Object::DeleteChild(Object *child)
     auto it = std::find(m_children.begin(), m_children.end(), child);
     if (it != m_children.end()) {
         m_children.erase(it);
+        IncrementTreeRevision();
         if (!m_isReferenceObject) {
             delete child;
         }
@@ -765,7 +807,10 @@ int Object::DeleteChildrenByComparison(Comparison *comparison)
             ++iter;
         }
     }
-    if (count > 0) this->Modify();
+    if (count > 0) {
+        IncrementTreeRevision();
+        this->Modify();
+    }
     return count;
 }
 
@@ -777,12 +822,14 @@ void Object::GenerateID()
 void Object::ResetID()
 {
     GenerateID();
+    IncrementTreeRevision();
 }
 
 void Object::SetParent(Object *parent)
 {
     assert(!m_parent);
     m_parent = parent;
+    IncrementTreeRevision();
 }
 
 bool Object::IsSupportedChild(Object *child)
@@ -1018,9 +1065,19 @@ void Object::Process(Functor &functor, int deepness, bool skipFirst)
         return;
     }
 
+    Profiler *profiler = Profiler::GetActive();
+    if (profiler && !profiler->IsProcessing(&functor)) {
+        // This is not a recursive call - profile the whole traversal
+        profiler->StartFunctor(&functor);
+        this->Process(functor, deepness, skipFirst);
+        profiler->EndScope();
+        return;
+    }
+
     if (!skipFirst) {
         FunctorCode code = this->Accept(functor);
         functor.SetCode(code);
+        if (profiler) profiler->AddVisit(&functor, this);
     }
 
     // do not go any deeper in this case
@@ -1066,15 +1123,97 @@ void Object::Process(Functor &functor, int deepness, bool skipFirst)
     }
 }
 
+void Object::Process(const std::vector<Functor *> &functors, int deepness)
+{
+    assert(!functors.empty());
+    assert(functors.size() <= MAX_FUSED_FUNCTORS);
+
+    uint32_t active = 0;
+    for (int i = 0; i < (int)functors.size(); ++i) {
+        // Direction, filters and visibility are common to all the functors of the traversal
+        assert(functors.at(i)->GetDirection() == FORWARD);
+        assert(!functors.at(i)->GetFilters());
+        assert(functors.at(i)->VisibleOnly() == functors.front()->VisibleOnly());
+        active |= (1u << i);
+    }
+
+    Profiler *profiler = Profiler::GetActive();
+    if (profiler) profiler->StartFunctors(functors);
+
+    this->ProcessFused(functors, active, deepness);
+
+    if (profiler) profiler->EndScope();
+}
+
+void Object::ProcessFused(const std::vector<Functor *> &functors, uint32_t active, int deepness)
+{
+    Profiler *profiler = Profiler::GetActive();
+
+    // The functors that are processed for the children and the end methods
+    uint32_t visiting = 0;
+    for (int i = 0; i < (int)functors.size(); ++i) {
+        if (!(active & (1u << i))) continue;
+        Functor *functor = functors[i];
+        if (functor->GetCode() == FUNCTOR_STOP) continue;
+
+        FunctorCode code = this->Accept(*functor);
+        functor->SetCode(code);
+        if (profiler) profiler->AddVisit(functor, this);
+
+        // do not go any deeper for this functor
+        if (functor->GetCode() == FUNCTOR_SIBLINGS) {
+            functor->SetCode(FUNCTOR_CONTINUE);
+            continue;
+        }
+        visiting |= (1u << i);
+    }
+
+    if (!visiting) return;
+
+    if (this->IsEditorialElement()) {
+        // since editorial object doesn't count, we increase the deepness limit
+        ++deepness;
+    }
+    if (deepness == 0) {
+        return;
+    }
+    --deepness;
+
+    if (!this->SkipChildren(functors.front()->VisibleOnly())) {
+        for (Object *child : m_children) {
+            child->ProcessFused(functors, visiting, deepness);
+        }
+    }
+
+    for (int i = 0; i < (int)functors.size(); ++i) {
+        if (!(visiting & (1u << i))) continue;
+        Functor *functor = functors[i];
+        if (functor->ImplementsEndInterface()) {
+            FunctorCode code = this->AcceptEnd(*functor);
+            functor->SetCode(code);
+        }
+    }
+}
+
 void Object::Process(ConstFunctor &functor, int deepness, bool skipFirst) const
 {
     if (functor.GetCode() == FUNCTOR_STOP) {
         return;
     }
 
+    Profiler *profiler = Profiler::GetActive();
+    if (profiler && !profiler->IsProcessing(&functor)) {
+        // This is not a recursive call - profile the whole traversal
+        profiler->StartFunctor(&functor);
+        this->Process(functor, deepness, skipFirst);
+        profiler->EndScope();
+        return;
+    }
+
     if (!skipFirst) {
         FunctorCode code = this->Accept(functor);
         functor.SetCode(code);
+        if (profiler) profiler->AddVisit(&functor, this);
     }
 
     // do not go any deeper in this case
@@ -0,0 +1,185 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        objectarena.cpp
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "objectarena.h"
+
+//----------------------------------------------------------------------------
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// ArenaHeader
+//----------------------------------------------------------------------------
+
+/**
+ * The header preceding every allocation.
+ * Its size is a multiple of the maximum alignment so the object remains aligned.
+ */
+union ArenaHeader {
+    struct {
+        ObjectArena *m_arena;
+        int m_sizeClass;
+    } m_info;
+    std::max_align_t m_align;
+};
+
+//----------------------------------------------------------------------------
+// ObjectArena
+//----------------------------------------------------------------------------
+
+thread_local ObjectArena *ObjectArena::s_current = NULL;
+
+ObjectArena::ObjectArena()
+{
+    m_currentChunk = 0;
+    m_chunkOffset = 0;
+    m_freeLists.resize(ARENA_MAX_SIZE / ARENA_SIZE_STEP + 1, NULL);
+    m_liveCount = 0;
+    m_released = false;
+    m_allocationCount = 0;
+    m_reuseCount = 0;
+}
+
+ObjectArena::~ObjectArena()
+{
+    assert(m_liveCount == 0);
+
+    this->ClearChunks();
+}
+
+void ObjectArena::Release()
+{
+    bool isDone = false;
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_released = true;
+        isDone = (m_liveCount == 0);
+    }
+    if (isDone) delete this;
+}
+
+void ObjectArena::ReleaseChunks()
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_liveCount != 0) return;
+
+    this->ClearChunks();
+}
+
+void *ObjectArena::Allocate(std::size_t size)
+{
+    void *block = NULL;
+    int sizeClass = -1;
+    ObjectArena *arena = s_current;
+
+    if (arena && (size <= ARENA_MAX_SIZE)) {
+        sizeClass = (int)((size + ARENA_SIZE_STEP - 1) / ARENA_SIZE_STEP);
+        block = arena->AllocateBlock(sizeClass);
+    }
+    else {
+        arena = NULL;
+        block = malloc(sizeof(ArenaHeader) + size);
+        if (!block) throw std::bad_alloc();
+    }
+
+    ArenaHeader *header = static_cast<ArenaHeader *>(block);
+    header->m_info.m_arena = arena;
+    header->m_info.m_sizeClass = sizeClass;
+    return header + 1;
+}
+
+void ObjectArena::Deallocate(void *ptr)
+{
+    if (!ptr) return;
+
+    ArenaHeader *header = static_cast<ArenaHeader *>(ptr) - 1;
+    ObjectArena *arena = header->m_info.m_arena;
+    if (!arena) {
+        free(header);
+        return;
+    }
+    if (arena->DeallocateBlock(header, header->m_info.m_sizeClass)) delete arena;
+}
+
+void *ObjectArena::AllocateBlock(int sizeClass)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    assert(!m_released);
+
+    ++m_liveCount;
+    ++m_allocationCount;
+
+    // First look in the free list of the size class
+    void *block = m_freeLists.at(sizeClass);
+    if (block) {
+        m_freeLists.at(sizeClass) = *static_cast<void **>(block);
+        ++m_reuseCount;
+        return block;
+    }
+
+    // Otherwise take it from the current chunk, moving to the next one (or a new one) if it does not fit
+    const size_t blockSize = sizeof(ArenaHeader) + sizeClass * ARENA_SIZE_STEP;
+    if (m_chunks.empty() || (m_chunkOffset + blockSize > ARENA_CHUNK_SIZE)) {
+        if (!m_chunks.empty()) ++m_currentChunk;
+        if (m_currentChunk == m_chunks.size()) {
+            char *chunk = static_cast<char *>(malloc(ARENA_CHUNK_SIZE));
+            if (!chunk) {
+                --m_liveCount;
+                throw std::bad_alloc();
+            }
+            m_chunks.push_back(chunk);
+        }
+        m_chunkOffset = 0;
+    }
+    block = m_chunks.at(m_currentChunk) + m_chunkOffset;
+    m_chunkOffset += blockSize;
+    return block;
+}
+
+bool ObjectArena::DeallocateBlock(void *block, int sizeClass)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    assert(m_liveCount > 0);
+
+    *static_cast<void **>(block) = m_freeLists.at(sizeClass);
+    m_freeLists.at(sizeClass) = block;
+    --m_liveCount;
+
+    return (m_released && (m_liveCount == 0));
+}
+
+void ObjectArena::ClearChunks()
+{
+    for (char *chunk : m_chunks) {
+        free(chunk);
+    }
+    m_chunks.clear();
+    m_currentChunk = 0;
+    m_chunkOffset = 0;
+    m_freeLists.assign(m_freeLists.size(), NULL);
+}
+
+//----------------------------------------------------------------------------
+// ObjectArenaScope
+//----------------------------------------------------------------------------
+
+ObjectArenaScope::ObjectArenaScope(ObjectArena *arena)
+{
+    m_previous = ObjectArena::GetCurrent();
+    ObjectArena::SetCurrent(arena);
+}
+
+ObjectArenaScope::~ObjectArenaScope()
+{
+    ObjectArena::SetCurrent(m_previous);
+}
+
+} // namespace vrv
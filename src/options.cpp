@@ -23,6 +23,9 @@
 
 namespace vrv {
 
+const std::map<int, std::string> Option::s_boundingBoxes = { { BOUNDINGBOXES_draw, "draw" },
+    { BOUNDINGBOXES_metrics, "metrics" }, { BOUNDINGBOXES_check, "check" } };
+
 const std::map<int, std::string> Option::s_breaks = { { BREAKS_none, "none" }, { BREAKS_auto, "auto" },
     { BREAKS_line, "line" }, { BREAKS_smart, "smart" }, { BREAKS_encoded, "encoded" } };
 
@@ -921,6 +924,12 @@ Options::Options()
     m_inputFrom.SetShortOption('f', false);
     m_baseOptions.AddOption(&m_inputFrom);
 
+    m_threads.SetInfo("Threads", "Number of threads for drawing all pages (default is the number of cores)");
+    m_threads.Init(0, 0, 256);
+    m_threads.SetKey("threads");
+    m_threads.SetShortOption('j', true);
+    m_baseOptions.AddOption(&m_threads);
+
     m_logLevel.SetInfo("Log level", "Set the log level: \"off\", \"error\", \"warning\", \"info\", or \"debug\"");
     m_logLevel.Init("warning");
     m_logLevel.SetKey("logLevel");
@@ -953,8 +962,8 @@ Options::Options()
 
     m_outputTo.SetInfo("Output to",
         "Select output format to: \"mei\", \"mei-pb\", \"mei-facs\", \"mei-basic\", \"svg\", \"midi\", \"timemap\", "
-        "\"expansionmap\", \"humdrum\" or "
-        "\"pae\"");
+        "\"expansionmap\", \"humdrum\", "
+        "\"pae\" or \"snapshot\"");
     m_outputTo.Init("svg");
     m_outputTo.SetKey("outputTo");
     m_outputTo.SetShortOption('t', true);
@@ -986,6 +995,12 @@ Options::Options()
     m_adjustPageWidth.Init(false);
     this->Register(&m_adjustPageWidth, "adjustPageWidth", &m_general);
 
+    m_boundingBoxes.SetInfo("Bounding boxes",
+        "Calculate the bounding boxes for the layout by drawing all elements, from the glyph metrics when possible "
+        "(faster), or from both with a warning for each difference");
+    m_boundingBoxes.Init(BOUNDINGBOXES_draw, &Option::s_boundingBoxes);
+    this->Register(&m_boundingBoxes, "boundingBoxes", &m_general);
+
     m_breaks.SetInfo("Breaks", "Define page and system breaks layout");
     m_breaks.Init(BREAKS_auto, &Option::s_breaks);
     this->Register(&m_breaks, "breaks", &m_general);
@@ -995,6 +1010,12 @@ Options::Options()
     m_breaksSmartSb.Init(0.66, 0.0, 1.0);
     this->Register(&m_breaksSmartSb, "breaksSmartSb", &m_general);
 
+    m_breaksEstimateHeight.SetInfo("Breaks estimate height",
+        "Break pages with an estimation of the system heights instead of the full vertical layout of the score (faster "
+        "for large scores but less accurate)");
+    m_breaksEstimateHeight.Init(false);
+    this->Register(&m_breaksEstimateHeight, "breaksEstimateHeight", &m_general);
+
     m_condense.SetInfo("Condense", "Control condensed score layout");
     m_condense.Init(CONDENSE_auto, &Option::s_condense);
     this->Register(&m_condense, "condense", &m_general);
@@ -1121,6 +1142,11 @@ Options::Options()
     m_preserveAnalyticalMarkup.Init(false);
     this->Register(&m_preserveAnalyticalMarkup, "preserveAnalyticalMarkup", &m_general);
 
+    m_profileTrace.SetInfo("Profile trace on CLI",
+        "Write the time spent in the functors and processing steps to a trace event file (chrome://tracing)");
+    m_profileTrace.Init("");
+    this->Register(&m_profileTrace, "profileTrace", &m_general);
+
     m_removeIds.SetInfo("Remove IDs in MEI", "Remove XML IDs in the MEI output that are not referenced");
     m_removeIds.Init(false);
     this->Register(&m_removeIds, "removeIds", &m_general);
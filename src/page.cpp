@@ -197,6 +197,8 @@ void Page::LayOut(bool force)
         return;
     }
 
+    this->ResetDrawingBBoxIndexes();
+
     this->LayOutHorizontally();
     this->JustifyHorizontally();
     this->LayOutVertically();
@@ -222,6 +224,8 @@ void Page::LayOutTranscription(bool force)
         return;
     }
 
+    this->ResetDrawingBBoxIndexes();
+
     Doc *doc = vrv_cast<Doc *>(this->GetFirstAncestor(DOC));
     assert(doc);
 
@@ -581,6 +585,43 @@ void Page::LayOutVertically()
     this->Process(alignSystems);
 }
 
+void Page::EstimateVerticalLayout()
+{
+    Doc *doc = vrv_cast<Doc *>(this->GetFirstAncestor(DOC));
+    assert(doc);
+
+    // Doc::SetDrawingPage should have been called before
+    // Make sure we have the correct page
+    assert(this == doc->GetDrawingPage());
+
+    // Reset the vertical alignment
+    ResetVerticalAlignmentFunctor resetVerticalAlignment;
+    this->Process(resetVerticalAlignment);
+
+    AlignVerticallyFunctor alignVertically(doc);
+    this->Process(alignVertically);
+
+    // Estimate the overflows instead of drawing the page and adjusting the floating elements
+    EstimateBBoxOverflowsFunctor estimateBBoxOverflows(doc);
+    this->Process(estimateBBoxOverflows);
+
+    AdjustYPosFunctor adjustYPos(doc);
+    this->Process(adjustYPos);
+
+    if (this->GetHeader()) {
+        this->GetHeader()->AdjustRunningElementYPos();
+    }
+
+    if (this->GetFooter()) {
+        this->GetFooter()->AdjustRunningElementYPos();
+    }
+
+    AlignSystemsFunctor alignSystems(doc);
+    alignSystems.SetShift(doc->m_drawingPageContentHeight);
+    alignSystems.SetSystemSpacing(doc->GetOptions()->m_spacingSystem.GetValue() * doc->GetDrawingUnit(100));
+    this->Process(alignSystems);
+}
+
 void Page::JustifyHorizontally()
 {
     Doc *doc = vrv_cast<Doc *>(this->GetFirstAncestor(DOC));
@@ -696,6 +737,8 @@ void Page::LayOutPitchPos()
 
     CalcStemFunctor calcStem(doc);
     this->Process(calcStem);
+
+    this->ResetDrawingBBoxIndexes();
 }
 
 int Page::GetContentHeight() const
@@ -704,8 +747,8 @@ int Page::GetContentHeight() const
     assert(doc);
 
     // Doc::SetDrawingPage should have been called before
-    // Make sure we have the correct page
-    assert(this == doc->GetDrawingPage());
+    // Make sure we have the correct page - or a page using the same sizes when drawing concurrently
+    assert((this == doc->GetDrawingPage()) || (m_pageHeight == -1));
 
     if (!this->GetChildCount()) {
         return 0;
@@ -730,8 +773,8 @@ int Page::GetContentWidth() const
     if (!doc) return 0;
 
     // Doc::SetDrawingPage should have been called before
-    // Make sure we have the correct page
-    assert(this == doc->GetDrawingPage());
+    // Make sure we have the correct page - or a page using the same sizes when drawing concurrently
+    assert((this == doc->GetDrawingPage()) || (m_pageHeight == -1));
 
     int maxWidth = 0;
     for (const Object *child : this->GetChildren()) {
@@ -748,6 +791,22 @@ int Page::GetContentWidth() const
     return maxWidth;
 }
 
+void Page::FindAllAtPoint(int x, int y, ListOfObjects &objects)
+{
+    for (Object *child : this->GetChildren()) {
+        System *system = dynamic_cast<System *>(child);
+        if (system) system->FindAllAtPoint(x, y, objects);
+    }
+}
+
+void Page::ResetDrawingBBoxIndexes()
+{
+    for (Object *child : this->GetChildren()) {
+        System *system = dynamic_cast<System *>(child);
+        if (system) system->ResetDrawingBBoxIndex();
+    }
+}
+
 void Page::AdjustSylSpacingByVerse(const IntTree &verseTree, Doc *doc)
 {
     IntTree_t::const_iterator staves;
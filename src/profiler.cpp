@@ -0,0 +1,326 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        profiler.cpp
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "profiler.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <typeinfo>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+//----------------------------------------------------------------------------
+
+#include "functor.h"
+#include "object.h"
+
+//----------------------------------------------------------------------------
+
+#include "jsonxx.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// ProfilerEntry
+//----------------------------------------------------------------------------
+
+ProfilerEntry::ProfilerEntry()
+{
+    m_calls = 0;
+    m_fusedCalls = 0;
+    m_time = 0.0;
+    m_visits = 0;
+}
+
+//----------------------------------------------------------------------------
+// Profiler
+//----------------------------------------------------------------------------
+
+thread_local Profiler *Profiler::s_active = NULL;
+
+Profiler::Profiler()
+{
+    this->Reset();
+}
+
+void Profiler::Reset()
+{
+    m_origin = std::chrono::steady_clock::now();
+    m_functorEntries.clear();
+    m_stepEntries.clear();
+    m_classNames.clear();
+    m_scopes.clear();
+    m_events.clear();
+}
+
+bool Profiler::IsProcessing(const FunctorBase *functor) const
+{
+    if (m_scopes.empty()) return false;
+
+    const Scope &scope = m_scopes.back();
+    return std::any_of(scope.m_functors.begin(), scope.m_functors.end(),
+        [functor](const std::pair<const FunctorBase *, ProfilerEntry *> &pair) { return (pair.first == functor); });
+}
+
+void Profiler::StartFunctor(const FunctorBase *functor)
+{
+    assert(functor);
+
+    Scope scope;
+    scope.m_functors.push_back({ functor, this->GetFunctorEntry(functor) });
+    scope.m_step = NULL;
+    scope.m_start = std::chrono::steady_clock::now();
+    m_scopes.push_back(scope);
+}
+
+void Profiler::StartFunctors(const std::vector<Functor *> &functors)
+{
+    Scope scope;
+    for (const Functor *functor : functors) {
+        scope.m_functors.push_back({ functor, this->GetFunctorEntry(functor) });
+    }
+    scope.m_step = NULL;
+    scope.m_start = std::chrono::steady_clock::now();
+    m_scopes.push_back(scope);
+}
+
+void Profiler::StartStep(const std::string &name)
+{
+    ProfilerEntry *entry = &m_stepEntries[name];
+    entry->m_name = name;
+
+    Scope scope;
+    scope.m_step = entry;
+    scope.m_start = std::chrono::steady_clock::now();
+    m_scopes.push_back(scope);
+}
+
+void Profiler::EndScope()
+{
+    assert(!m_scopes.empty());
+
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    const Scope &scope = m_scopes.back();
+    const double time = std::chrono::duration<double, std::milli>(end - scope.m_start).count();
+
+    Event event;
+    event.m_start = this->GetTimestamp(scope.m_start);
+    event.m_duration = time * 1000.0;
+
+    if (scope.m_step) {
+        scope.m_step->m_calls++;
+        scope.m_step->m_time += time;
+        event.m_name = scope.m_step->m_name;
+        event.m_isStep = true;
+    }
+    else {
+        // With several functors processed together, each of them gets the time of the whole traversal
+        const bool isFused = (scope.m_functors.size() > 1);
+        for (auto &[functor, entry] : scope.m_functors) {
+            entry->m_calls++;
+            if (isFused) entry->m_fusedCalls++;
+            entry->m_time += time;
+            if (!event.m_name.empty()) event.m_name += " + ";
+            event.m_name += entry->m_name;
+        }
+        event.m_isStep = false;
+    }
+    m_events.push_back(event);
+
+    m_scopes.pop_back();
+}
+
+void Profiler::AddStep(
+    const std::string &name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    ProfilerEntry *entry = &m_stepEntries[name];
+    entry->m_name = name;
+    entry->m_calls++;
+    const double time = std::chrono::duration<double, std::milli>(end - start).count();
+    entry->m_time += time;
+
+    Event event;
+    event.m_name = name;
+    event.m_isStep = true;
+    event.m_start = this->GetTimestamp(start);
+    event.m_duration = time * 1000.0;
+    m_events.push_back(event);
+}
+
+void Profiler::AddVisit(const FunctorBase *functor, const Object *object)
+{
+    assert(!m_scopes.empty());
+
+    for (auto &[scopeFunctor, entry] : m_scopes.back().m_functors) {
+        if (scopeFunctor != functor) continue;
+
+        const ClassId classId = object->GetClassId();
+        if (entry->m_classVisits.size() <= classId) {
+            entry->m_classVisits.resize(classId + 1, 0);
+        }
+        entry->m_visits++;
+        entry->m_classVisits.at(classId)++;
+
+        // Keep the class name the first time we see it
+        if (m_classNames.size() <= classId) {
+            m_classNames.resize(classId + 1);
+        }
+        if (m_classNames.at(classId).empty()) {
+            m_classNames.at(classId) = object->GetClassName();
+            // Some classes (e.g., the aligners) do not override it
+            if (m_classNames.at(classId) == "[MISSING]") m_classNames.at(classId) = GetTypeName(typeid(*object));
+        }
+        return;
+    }
+}
+
+std::vector<const ProfilerEntry *> Profiler::GetFunctorEntries() const
+{
+    std::vector<const ProfilerEntry *> entries;
+    for (const auto &[type, entry] : m_functorEntries) {
+        entries.push_back(&entry);
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const ProfilerEntry *entry1, const ProfilerEntry *entry2) { return (entry1->m_time > entry2->m_time); });
+    return entries;
+}
+
+std::vector<const ProfilerEntry *> Profiler::GetStepEntries() const
+{
+    std::vector<const ProfilerEntry *> entries;
+    for (const auto &[name, entry] : m_stepEntries) {
+        entries.push_back(&entry);
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const ProfilerEntry *entry1, const ProfilerEntry *entry2) { return (entry1->m_time > entry2->m_time); });
+    return entries;
+}
+
+std::string Profiler::GetClassName(ClassId classId) const
+{
+    if (m_classNames.size() <= classId) return "";
+    return m_classNames.at(classId);
+}
+
+std::string Profiler::GetProfileJSON() const
+{
+    jsonxx::Object profile;
+
+    jsonxx::Array functors;
+    for (const ProfilerEntry *entry : this->GetFunctorEntries()) {
+        jsonxx::Object functor;
+        functor << "name" << entry->m_name;
+        functor << "calls" << entry->m_calls;
+        if (entry->m_fusedCalls > 0) functor << "fusedCalls" << entry->m_fusedCalls;
+        jsonxx::Value time(entry->m_time);
+        time.precision_ = 3;
+        functor << "time" << time;
+        functor << "visits" << entry->m_visits;
+        jsonxx::Object classVisits;
+        for (int classId = 0; classId < (int)entry->m_classVisits.size(); ++classId) {
+            if (entry->m_classVisits.at(classId) == 0) continue;
+            classVisits << this->GetClassName((ClassId)classId) << entry->m_classVisits.at(classId);
+        }
+        functor << "classVisits" << classVisits;
+        functors << functor;
+    }
+    profile << "functors" << functors;
+
+    jsonxx::Array steps;
+    for (const ProfilerEntry *entry : this->GetStepEntries()) {
+        jsonxx::Object step;
+        step << "name" << entry->m_name;
+        step << "calls" << entry->m_calls;
+        jsonxx::Value time(entry->m_time);
+        time.precision_ = 3;
+        step << "time" << time;
+        steps << step;
+    }
+    profile << "steps" << steps;
+
+    return profile.json();
+}
+
+std::string Profiler::GetTraceJSON() const
+{
+    jsonxx::Object trace;
+
+    jsonxx::Array events;
+    for (const Event &event : m_events) {
+        // Complete events with the timestamp and the duration in microseconds
+        jsonxx::Object traceEvent;
+        traceEvent << "name" << event.m_name;
+        traceEvent << "cat" << ((event.m_isStep) ? "step" : "functor");
+        traceEvent << "ph" << "X";
+        jsonxx::Value start(event.m_start);
+        start.precision_ = 3;
+        traceEvent << "ts" << start;
+        jsonxx::Value duration(event.m_duration);
+        duration.precision_ = 3;
+        traceEvent << "dur" << duration;
+        traceEvent << "pid" << 1;
+        traceEvent << "tid" << 1;
+        events << traceEvent;
+    }
+    trace << "traceEvents" << events;
+    trace << "displayTimeUnit" << "ms";
+
+    return trace.json();
+}
+
+ProfilerEntry *Profiler::GetFunctorEntry(const FunctorBase *functor)
+{
+    const std::type_index type(typeid(*functor));
+    auto iter = m_functorEntries.find(type);
+    if (iter != m_functorEntries.end()) return &iter->second;
+
+    ProfilerEntry *entry = &m_functorEntries[type];
+    entry->m_name = GetTypeName(typeid(*functor));
+    return entry;
+}
+
+std::string Profiler::GetTypeName(const std::type_info &typeInfo)
+{
+    std::string name = typeInfo.name();
+#ifdef __GNUG__
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(name.c_str(), NULL, NULL, &status);
+    if (demangled && (status == 0)) name = demangled;
+    free(demangled);
+#endif
+    // Remove the namespace (and the "class " prefix with MSVC)
+    const size_t pos = name.rfind("::");
+    if (pos != std::string::npos) name = name.substr(pos + 2);
+    return name;
+}
+
+double Profiler::GetTimestamp(std::chrono::steady_clock::time_point timePoint) const
+{
+    return std::chrono::duration<double, std::micro>(timePoint - m_origin).count();
+}
+
+//----------------------------------------------------------------------------
+// ProfilerStep
+//----------------------------------------------------------------------------
+
+ProfilerStep::ProfilerStep(const char *name)
+{
+    m_profiler = Profiler::GetActive();
+    if (m_profiler) m_profiler->StartStep(name);
+}
+
+ProfilerStep::~ProfilerStep()
+{
+    if (m_profiler) m_profiler->EndScope();
+}
+
+} // namespace vrv
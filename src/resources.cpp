@@ -9,6 +9,8 @@
 
 //----------------------------------------------------------------------------
 
+#include <cassert>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -28,6 +30,10 @@
 #define BRAVURA "Bravura"
 #define LEIPZIG "Leipzig"
 
+#define GLYPH_TABLE_MAGIC "VRVG"
+#define GLYPH_TABLE_VERSION 1
+#define GLYPH_TABLE_NO_STRING 0xFFFFFFFF
+
 namespace vrv {
 
 //----------------------------------------------------------------------------
@@ -35,6 +41,8 @@ namespace vrv {
 //----------------------------------------------------------------------------
 
 thread_local std::string Resources::s_defaultPath = VRV_RESOURCE_DIR;
+thread_local Resources::StyleAttributes Resources::s_currentStyle{ data_FONTWEIGHT::FONTWEIGHT_normal,
+    data_FONTSTYLE::FONTSTYLE_normal };
 const Resources::StyleAttributes Resources::k_defaultStyle{ data_FONTWEIGHT::FONTWEIGHT_normal,
     data_FONTSTYLE::FONTSTYLE_normal };
 
@@ -54,7 +62,7 @@ void SetDefaultResourcePath(const std::string &path)
 Resources::Resources()
 {
     m_path = s_defaultPath;
-    m_currentStyle = k_defaultStyle;
+    s_currentStyle = k_defaultStyle;
 }
 
 bool Resources::InitFonts()
@@ -88,7 +96,7 @@ bool Resources::InitFonts()
         }
     }
 
-    m_currentStyle = k_defaultStyle;
+    s_currentStyle = k_defaultStyle;
 
     return true;
 }
@@ -259,16 +267,16 @@ void Resources::SelectTextFont(data_FONTWEIGHT fontWeight, data_FONTSTYLE fontSt
         fontStyle = FONTSTYLE_normal;
     }
 
-    m_currentStyle = { fontWeight, fontStyle };
-    if (m_textFont.count(m_currentStyle) == 0) {
+    s_currentStyle = { fontWeight, fontStyle };
+    if (m_textFont.count(s_currentStyle) == 0) {
         LogWarning("Text font for style (%d, %d) is not loaded. Use default", fontWeight, fontStyle);
-        m_currentStyle = k_defaultStyle;
+        s_currentStyle = k_defaultStyle;
     }
 }
 
 const Glyph *Resources::GetTextGlyph(char32_t code) const
 {
-    const StyleAttributes style = (m_textFont.count(m_currentStyle) != 0) ? m_currentStyle : k_defaultStyle;
+    const StyleAttributes style = (m_textFont.count(s_currentStyle) != 0) ? s_currentStyle : k_defaultStyle;
     if (m_textFont.count(style) == 0) return NULL;
 
     const GlyphTable &currentTable = m_textFont.at(style);
@@ -294,6 +302,10 @@ char32_t Resources::GetSmuflGlyphForUnicodeChar(const char32_t unicodeChar)
 
 bool Resources::LoadFont(const std::string &fontName, ZipFileReader *zipFile)
 {
+    // For fonts in the resource directory, use the binary glyph table when it is available
+    BinaryGlyphTable binaryTable;
+    const bool isBinary = (!zipFile && binaryTable.Open(Resources::GetPath() + "/" + fontName));
+
     pugi::xml_document doc;
     // For zip archive custom font, load the data from the zipFile
     if (zipFile) {
@@ -311,7 +323,7 @@ bool Resources::LoadFont(const std::string &fontName, ZipFileReader *zipFile)
         }
     }
     // Other wise use the resource directory
-    else {
+    else if (!isBinary) {
         const std::string filename = Resources::GetPath() + "/" + fontName + ".xml";
         pugi::xml_parse_result parseResult = doc.load_file(filename.c_str());
         if (!parseResult) {
@@ -321,7 +333,7 @@ bool Resources::LoadFont(const std::string &fontName, ZipFileReader *zipFile)
         }
     }
     pugi::xml_node root = doc.first_child();
-    if (!root.attribute("units-per-em")) {
+    if (!isBinary && !root.attribute("units-per-em")) {
         LogError("No units-per-em attribute in bounding box file");
         return false;
     }
@@ -339,50 +351,82 @@ bool Resources::LoadFont(const std::string &fontName, ZipFileReader *zipFile)
 
     GlyphTable &glyphTable = font.GetGlyphTableForModification();
 
-    const int unitsPerEm = atoi(root.attribute("units-per-em").value());
-
-    for (pugi::xml_node current = root.child("g"); current; current = current.next_sibling("g")) {
-        pugi::xml_attribute c_attribute = current.attribute("c");
-        pugi::xml_attribute n_attribute = current.attribute("n");
-        if (!c_attribute || !n_attribute) continue;
-
-        Glyph glyph;
-        glyph.SetUnitsPerEm(unitsPerEm * 10);
-        glyph.SetCodeStr(c_attribute.value());
-        float x = 0.0, y = 0.0, width = 0.0, height = 0.0;
-        if (current.attribute("x")) x = current.attribute("x").as_float();
-        if (current.attribute("y")) y = current.attribute("y").as_float();
-        if (current.attribute("w")) width = current.attribute("w").as_float();
-        if (current.attribute("h")) height = current.attribute("h").as_float();
-        glyph.SetBoundingBox(x, y, width, height);
-
-        std::string glyphFilename = fontName + "/" + c_attribute.value() + ".xml";
-        // Store the XML in the glyph for fonts loaded from zip files
-        if (zipFile) {
-            glyph.SetXML(zipFile->ReadTextFile(glyphFilename));
-        }
-        // Otherwise only store the path
-        else {
-            glyph.SetPath(Resources::GetPath() + "/" + glyphFilename);
+    if (isBinary) {
+        const int unitsPerEm = binaryTable.GetUnitsPerEm();
+        glyphTable.reserve(binaryTable.GetGlyphCount());
+        if (buildNameTable) m_glyphNameTable.reserve(binaryTable.GetGlyphCount());
+
+        for (uint32_t i = 0; i < binaryTable.GetGlyphCount(); ++i) {
+            const BinaryGlyphTable::GlyphRecord record = binaryTable.GetGlyph(i);
+            const char *name = binaryTable.GetString(record.m_name);
+            if (!name) continue;
+
+            Glyph glyph;
+            glyph.SetUnitsPerEm(unitsPerEm * 10);
+            const char *codeStr = binaryTable.GetString(record.m_codeStr);
+            glyph.SetCodeStr(codeStr);
+            glyph.SetBoundingBox(record.m_x, record.m_y, record.m_width, record.m_height);
+            glyph.SetPath(Resources::GetPath() + "/" + fontName + "/" + codeStr + ".xml");
+            glyph.SetHorizAdvX(record.m_horizAdvX);
+
+            for (uint32_t j = record.m_firstAnchor; j < record.m_firstAnchor + record.m_anchorCount; ++j) {
+                const BinaryGlyphTable::AnchorRecord anchor = binaryTable.GetAnchor(j);
+                glyph.SetAnchor(binaryTable.GetString(anchor.m_name), anchor.m_x, anchor.m_y);
+            }
+
+            const char32_t smuflCode = (char32_t)record.m_code;
+            glyphTable[smuflCode] = std::move(glyph);
+            if (buildNameTable) {
+                m_glyphNameTable[name] = smuflCode;
+            }
         }
+    }
+    else {
+        const int unitsPerEm = atoi(root.attribute("units-per-em").value());
 
-        if (current.attribute("h-a-x")) glyph.SetHorizAdvX(current.attribute("h-a-x").as_float());
+        for (pugi::xml_node current = root.child("g"); current; current = current.next_sibling("g")) {
+            pugi::xml_attribute c_attribute = current.attribute("c");
+            pugi::xml_attribute n_attribute = current.attribute("n");
+            if (!c_attribute || !n_attribute) continue;
 
-        // load anchors
-        pugi::xml_node anchor;
-        for (anchor = current.child("a"); anchor; anchor = anchor.next_sibling("a")) {
-            if (anchor.attribute("n")) {
-                std::string name = std::string(anchor.attribute("n").value());
-                // No check for possible x and y missing attributes - not very safe.
+            Glyph glyph;
+            glyph.SetUnitsPerEm(unitsPerEm * 10);
+            glyph.SetCodeStr(c_attribute.value());
+            float x = 0.0, y = 0.0, width = 0.0, height = 0.0;
+            if (current.attribute("x")) x = current.attribute("x").as_float();
+            if (current.attribute("y")) y = current.attribute("y").as_float();
+            if (current.attribute("w")) width = current.attribute("w").as_float();
+            if (current.attribute("h")) height = current.attribute("h").as_float();
+            glyph.SetBoundingBox(x, y, width, height);
 
-                glyph.SetAnchor(name, anchor.attribute("x").as_float(), anchor.attribute("y").as_float());
+            std::string glyphFilename = fontName + "/" + c_attribute.value() + ".xml";
+            // Store the XML in the glyph for fonts loaded from zip files
+            if (zipFile) {
+                glyph.SetXML(zipFile->ReadTextFile(glyphFilename));
+            }
+            // Otherwise only store the path
+            else {
+                glyph.SetPath(Resources::GetPath() + "/" + glyphFilename);
             }
-        }
 
-        const char32_t smuflCode = (char32_t)strtol(c_attribute.value(), NULL, 16);
-        glyphTable[smuflCode] = glyph;
-        if (buildNameTable) {
-            m_glyphNameTable[n_attribute.value()] = smuflCode;
+            if (current.attribute("h-a-x")) glyph.SetHorizAdvX(current.attribute("h-a-x").as_float());
+
+            // load anchors
+            pugi::xml_node anchor;
+            for (anchor = current.child("a"); anchor; anchor = anchor.next_sibling("a")) {
+                if (anchor.attribute("n")) {
+                    std::string name = std::string(anchor.attribute("n").value());
+                    // No check for possible x and y missing attributes - not very safe.
+
+                    glyph.SetAnchor(name, anchor.attribute("x").as_float(), anchor.attribute("y").as_float());
+                }
+            }
+
+            const char32_t smuflCode = (char32_t)strtol(c_attribute.value(), NULL, 16);
+            glyphTable[smuflCode] = glyph;
+            if (buildNameTable) {
+                m_glyphNameTable[n_attribute.value()] = smuflCode;
+            }
         }
     }
 
@@ -397,9 +441,26 @@ bool Resources::LoadFont(const std::string &fontName, ZipFileReader *zipFile)
 bool Resources::InitTextFont(const std::string &fontName, const StyleAttributes &style)
 {
     // For the text font, we load the bounding boxes only
-    pugi::xml_document doc;
     // For now, we have only Times bounding boxes for ASCII chars
     // For any other char, we currently use 'o' bounding box
+    BinaryGlyphTable binaryTable;
+    if (binaryTable.Open(GetPath() + "/text/" + fontName)) {
+        GlyphTable &currentTable = m_textFont[style];
+        currentTable.reserve(currentTable.size() + binaryTable.GetGlyphCount());
+        for (uint32_t i = 0; i < binaryTable.GetGlyphCount(); ++i) {
+            const BinaryGlyphTable::GlyphRecord record = binaryTable.GetGlyph(i);
+            Glyph glyph(binaryTable.GetUnitsPerEm());
+            glyph.SetBoundingBox(record.m_x, record.m_y, record.m_width, record.m_height);
+            glyph.SetHorizAdvX(record.m_horizAdvX);
+            if (currentTable.count(record.m_code) > 0) {
+                LogDebug("Redefining %d with %s", record.m_code, fontName.c_str());
+            }
+            currentTable[(char32_t)record.m_code] = std::move(glyph);
+        }
+        return true;
+    }
+
+    pugi::xml_document doc;
     std::string filename = GetPath() + "/text/" + fontName + ".xml";
     pugi::xml_parse_result result = doc.load_file(filename.c_str());
     if (!result) {
@@ -456,4 +517,105 @@ std::string Resources::LoadedFont::GetCSSFont(const std::string &path) const
     }
 }
 
+//----------------------------------------------------------------------------
+// Resources::BinaryGlyphTable
+//----------------------------------------------------------------------------
+
+Resources::BinaryGlyphTable::BinaryGlyphTable()
+{
+    // The record layouts have to match the ones written by fonts/generate_binary.py
+    static_assert(sizeof(Header) == 32, "Unexpected binary glyph table header size");
+    static_assert(sizeof(GlyphRecord) == 40, "Unexpected binary glyph record size");
+    static_assert(sizeof(AnchorRecord) == 12, "Unexpected binary anchor record size");
+
+    memset(&m_header, 0, sizeof(Header));
+    m_glyphs = NULL;
+    m_anchors = NULL;
+    m_strings = NULL;
+}
+
+bool Resources::BinaryGlyphTable::Open(const std::string &basename)
+{
+    const std::string filename = basename + ".bin";
+    if (!m_file.Open(filename)) return false;
+
+    if (m_file.GetSize() < sizeof(Header)) {
+        LogWarning("Binary glyph table '%s' is invalid and is ignored", filename.c_str());
+        return false;
+    }
+    const char *data = m_file.GetView().data();
+    memcpy(&m_header, data, sizeof(Header));
+    m_glyphs = data + sizeof(Header);
+    m_anchors = m_glyphs + (size_t)m_header.m_glyphCount * sizeof(GlyphRecord);
+    m_strings = m_anchors + (size_t)m_header.m_anchorCount * sizeof(AnchorRecord);
+
+    if (!this->IsValid()) {
+        LogWarning("Binary glyph table '%s' is invalid and is ignored", filename.c_str());
+        return false;
+    }
+
+    // The table is generated from the XML file, which remains the reference
+    std::error_code errorCode;
+    const std::uintmax_t xmlSize = std::filesystem::file_size(basename + ".xml", errorCode);
+    if (!errorCode && (xmlSize != m_header.m_sourceSize)) {
+        LogWarning("Binary glyph table '%s' is out of date and is ignored", filename.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool Resources::BinaryGlyphTable::IsValid() const
+{
+    if (memcmp(m_header.m_magic, GLYPH_TABLE_MAGIC, 4) != 0) return false;
+    // This also rejects tables read on big-endian platforms
+    if (m_header.m_version != GLYPH_TABLE_VERSION) return false;
+    if (m_header.m_unitsPerEm <= 0) return false;
+
+    const uint64_t expectedSize = sizeof(Header) + (uint64_t)m_header.m_glyphCount * sizeof(GlyphRecord)
+        + (uint64_t)m_header.m_anchorCount * sizeof(AnchorRecord) + m_header.m_stringsSize;
+    if (m_file.GetSize() != expectedSize) return false;
+    if ((m_header.m_stringsSize == 0) || (m_strings[m_header.m_stringsSize - 1] != '\0')) return false;
+
+    // Check the offsets once so that they can be used without checking when loading
+    for (uint32_t i = 0; i < m_header.m_glyphCount; ++i) {
+        const GlyphRecord record = this->GetGlyph(i);
+        if (record.m_codeStr >= m_header.m_stringsSize) return false;
+        if ((record.m_name != GLYPH_TABLE_NO_STRING) && (record.m_name >= m_header.m_stringsSize)) return false;
+        if ((uint64_t)record.m_firstAnchor + record.m_anchorCount > m_header.m_anchorCount) return false;
+    }
+    for (uint32_t i = 0; i < m_header.m_anchorCount; ++i) {
+        if (this->GetAnchor(i).m_name >= m_header.m_stringsSize) return false;
+    }
+
+    return true;
+}
+
+Resources::BinaryGlyphTable::GlyphRecord Resources::BinaryGlyphTable::GetGlyph(uint32_t idx) const
+{
+    assert(idx < m_header.m_glyphCount);
+
+    // Copy the record since the mapped data is not guaranteed to be aligned
+    GlyphRecord record;
+    memcpy(&record, m_glyphs + (size_t)idx * sizeof(GlyphRecord), sizeof(GlyphRecord));
+    return record;
+}
+
+Resources::BinaryGlyphTable::AnchorRecord Resources::BinaryGlyphTable::GetAnchor(uint32_t idx) const
+{
+    assert(idx < m_header.m_anchorCount);
+
+    AnchorRecord record;
+    memcpy(&record, m_anchors + (size_t)idx * sizeof(AnchorRecord), sizeof(AnchorRecord));
+    return record;
+}
+
+const char *Resources::BinaryGlyphTable::GetString(uint32_t offset) const
+{
+    if (offset == GLYPH_TABLE_NO_STRING) return NULL;
+
+    assert(offset < m_header.m_stringsSize);
+    return m_strings + offset;
+}
+
 } // namespace vrv
@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        snapshot.cpp
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "snapshot.h"
+
+//----------------------------------------------------------------------------
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+//----------------------------------------------------------------------------
+
+#include "vrv.h"
+
+#define SNAPSHOT_MAGIC "VRVS"
+#define SNAPSHOT_VERSION 1
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// Snapshot
+//----------------------------------------------------------------------------
+
+Snapshot::Snapshot()
+{
+    static_assert(sizeof(Header) == 32, "Unexpected snapshot header size");
+    static_assert(sizeof(CastOffRecord) == 16, "Unexpected snapshot record size");
+
+    memset(&m_header, 0, sizeof(Header));
+    m_records = NULL;
+}
+
+bool Snapshot::IsSnapshot(std::string_view data)
+{
+    return ((data.size() >= sizeof(Header)) && (memcmp(data.data(), SNAPSHOT_MAGIC, 4) == 0));
+}
+
+bool Snapshot::Read(std::string_view data)
+{
+    if (!IsSnapshot(data)) return false;
+
+    memcpy(&m_header, data.data(), sizeof(Header));
+    // This also rejects snapshots read on big-endian platforms
+    if (m_header.m_version != SNAPSHOT_VERSION) return false;
+
+    const uint64_t expectedSize = sizeof(Header) + (uint64_t)m_header.m_signatureSize
+        + (uint64_t)m_header.m_recordCount * sizeof(CastOffRecord) + m_header.m_meiSize;
+    if (data.size() != expectedSize) return false;
+
+    size_t offset = sizeof(Header);
+    m_signature = data.substr(offset, m_header.m_signatureSize);
+    offset += m_header.m_signatureSize;
+    m_records = data.data() + offset;
+    offset += (size_t)m_header.m_recordCount * sizeof(CastOffRecord);
+    m_mei = data.substr(offset, m_header.m_meiSize);
+
+    return true;
+}
+
+bool Snapshot::Write(const std::string &filename, const std::string &signature,
+    const std::vector<CastOffRecord> &layout, const std::string &mei)
+{
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    memcpy(header.m_magic, SNAPSHOT_MAGIC, 4);
+    header.m_version = SNAPSHOT_VERSION;
+    header.m_signatureSize = (uint32_t)signature.size();
+    header.m_recordCount = (uint32_t)layout.size();
+    header.m_meiSize = mei.size();
+
+    std::ofstream outfile;
+    outfile.open(filename.c_str(), std::ios::binary);
+    if (!outfile.is_open()) {
+        return false;
+    }
+    outfile.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    outfile.write(signature.data(), signature.size());
+    outfile.write(reinterpret_cast<const char *>(layout.data()), layout.size() * sizeof(CastOffRecord));
+    outfile.write(mei.data(), mei.size());
+    outfile.close();
+
+    return outfile.good();
+}
+
+void Snapshot::GetLayout(std::vector<CastOffRecord> &layout) const
+{
+    layout.resize(m_header.m_recordCount);
+    if (m_header.m_recordCount == 0) return;
+
+    assert(m_records);
+    // Copy the records since the data is not guaranteed to be aligned
+    memcpy(layout.data(), m_records, layout.size() * sizeof(CastOffRecord));
+}
+
+} // namespace vrv
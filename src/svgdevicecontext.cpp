@@ -10,6 +10,7 @@
 //----------------------------------------------------------------------------
 
 #include <cassert>
+#include <cstring>
 
 //----------------------------------------------------------------------------
 
@@ -69,8 +70,6 @@ SvgDeviceContext::SvgDeviceContext() : DeviceContext(SVG_DEVICE_CONTEXT)
     m_svgNodeStack.push_back(m_svgNode);
     m_currentNode = m_svgNode;
 
-    m_outdata.clear();
-
     m_glyphPostfixId = Object::GenerateHashID();
 }
 
@@ -230,7 +229,16 @@ void SvgDeviceContext::Commit(bool xml_declaration)
 
     // save the glyph data to m_outdata
     std::string indent = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
-    m_svgDoc.save(m_outdata, indent.c_str(), output_flags);
+    StringWriter writer(m_outdata);
+    m_svgDoc.save(writer, indent.c_str(), output_flags);
+
+    // the document is not needed anymore once serialized
+    m_graphicNodes.clear();
+    m_svgNodeStack.clear();
+    m_svgNode = pugi::xml_node();
+    m_pageNode = pugi::xml_node();
+    m_currentNode = pugi::xml_node();
+    m_svgDoc.reset();
 
     m_committed = true;
 }
@@ -410,11 +418,20 @@ void SvgDeviceContext::StartTextGraphic(Object *object, const std::string &gClas
 
 void SvgDeviceContext::ResumeGraphic(Object *object, std::string gId)
 {
-    std::string xpathPrefix = m_html5 ? "//g[@data-id=\"" : "//g[@id=\"";
-    std::string xpath = xpathPrefix + gId + "\"]";
-    pugi::xpath_node selection = m_currentNode.select_node(xpath.c_str());
-    if (selection) {
-        m_currentNode = selection.node();
+    auto it = m_graphicNodes.find(gId);
+    if (it != m_graphicNodes.end()) {
+        if (it->second) {
+            m_currentNode = it->second;
+        }
+        // The id is not unique, look for the first one in the document
+        else {
+            std::string xpathPrefix = m_html5 ? "//g[@data-id=\"" : "//g[@id=\"";
+            std::string xpath = xpathPrefix + gId + "\"]";
+            pugi::xpath_node selection = m_currentNode.select_node(xpath.c_str());
+            if (selection) {
+                m_currentNode = selection.node();
+            }
+        }
     }
     m_svgNodeStack.push_back(m_currentNode);
 }
@@ -569,6 +586,25 @@ Point SvgDeviceContext::GetLogicalOrigin()
     return Point(m_originX, m_originY);
 }
 
+void SvgDeviceContext::IndexGraphic(pugi::xml_node node, const std::string &gId)
+{
+    auto [it, inserted] = m_graphicNodes.try_emplace(gId, node);
+    if (!inserted) it->second = pugi::xml_node();
+}
+
+void SvgDeviceContext::IndexGraphicSubtree(pugi::xml_node node)
+{
+    if (node.type() != pugi::node_element) return;
+
+    if (!strcmp(node.name(), "g")) {
+        pugi::xml_attribute id = node.attribute(m_html5 ? "data-id" : "id");
+        if (id) this->IndexGraphic(node, id.value());
+    }
+    for (pugi::xml_node child : node.children()) {
+        this->IndexGraphicSubtree(child);
+    }
+}
+
 pugi::xml_node SvgDeviceContext::AddChild(std::string name)
 {
     pugi::xml_node g = m_currentNode.child("g");
@@ -964,8 +1000,12 @@ void SvgDeviceContext::DrawText(
         svgText.replace(svgText.size() - 1, 1, "\xC2\xA0");
     }
 
-    pugi::xpath_node fontNode = m_currentNode.select_node("ancestor::*[@font-family][1]");
-    std::string currentFaceName = (fontNode) ? fontNode.node().attribute("font-family").value() : "";
+    // Look for the closest ancestor with a @font-family (the current node excluded)
+    pugi::xml_node fontNode = m_currentNode.parent();
+    while (fontNode && !fontNode.attribute("font-family")) {
+        fontNode = fontNode.parent();
+    }
+    std::string currentFaceName = (fontNode) ? fontNode.attribute("font-family").value() : "";
     std::string fontFaceName = m_fontStack.top()->GetFaceName();
 
     pugi::xml_node textChild = AddChild("tspan");
@@ -1089,10 +1129,15 @@ void SvgDeviceContext::DrawSvgShape(int x, int y, int width, int height, double
               .c_str();
 
     // Remove the ID in the SVG because it might be duplicated and that will not be valid
+    pugi::xml_attribute id = m_currentNode.attribute("id");
+    if (id && !m_html5) {
+        auto it = m_graphicNodes.find(id.value());
+        if ((it != m_graphicNodes.end()) && (it->second == m_currentNode)) m_graphicNodes.erase(it);
+    }
     m_currentNode.remove_attribute("id");
 
     for (pugi::xml_node child : svg.children()) {
-        m_currentNode.append_copy(child);
+        this->IndexGraphicSubtree(m_currentNode.append_copy(child));
     }
 }
 
@@ -1119,6 +1164,9 @@ void SvgDeviceContext::AppendIdAndClass(
             // an HTML document.
             m_currentNode.append_attribute("id") = gId.c_str();
         }
+        if ((m_html5 || (graphicID == PRIMARY)) && !strcmp(m_currentNode.name(), "g")) {
+            this->IndexGraphic(m_currentNode, gId);
+        }
     }
 
     if (m_html5) {
@@ -1178,7 +1226,7 @@ std::string SvgDeviceContext::GetStringSVG(bool xml_declaration)
 {
     if (!m_committed) Commit(xml_declaration);
 
-    return m_outdata.str();
+    return m_outdata;
 }
 
 void SvgDeviceContext::DrawSvgBoundingBoxRectangle(int x, int y, int width, int height)
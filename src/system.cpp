@@ -9,6 +9,7 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cassert>
 
 //----------------------------------------------------------------------------
@@ -23,6 +24,7 @@
 #include "ending.h"
 #include "findfunctor.h"
 #include "findlayerelementsfunctor.h"
+#include "floatingobject.h"
 #include "layer.h"
 #include "measure.h"
 #include "miscfunctor.h"
@@ -163,6 +165,14 @@ int System::GetMinimumSystemSpacing(const Doc *doc) const
     return spacingSystem.GetValue() * doc->GetDrawingUnit(100);
 }
 
+bool System::HasDirtyMeasures() const
+{
+    const ArrayOfConstObjects children = this->GetChildren();
+    return std::any_of(children.begin(), children.end(), [](const Object *child) {
+        return (child->Is(MEASURE) && vrv_cast<const Measure *>(child)->IsDirty());
+    });
+}
+
 int System::GetDrawingLabelsWidth() const
 {
     return (m_drawingScoreDef) ? m_drawingScoreDef->GetDrawingLabelsWidth() : 0;
@@ -429,6 +439,59 @@ double System::EstimateJustificationRatio(const Doc *doc) const
     return estimatedRatio;
 }
 
+void System::FindAllAtPoint(int x, int y, ListOfObjects &objects)
+{
+    if (m_drawingBBoxIndex.IsEmpty()) {
+        const Doc *doc = vrv_cast<const Doc *>(this->GetFirstAncestor(DOC));
+        assert(doc);
+
+        // The boxes of the objects and of the positioners of the floating objects
+        ListOfObjects descendants;
+        HasSelfBBComparison hasSelfBB;
+        this->FindAllDescendantsByComparison(&descendants, &hasSelfBB);
+        ArrayOfBoundingBoxes boxes(descendants.begin(), descendants.end());
+        for (Object *child : m_systemAligner.GetChildren()) {
+            StaffAlignment *staffAlignment = vrv_cast<StaffAlignment *>(child);
+            assert(staffAlignment);
+            for (FloatingPositioner *positioner : staffAlignment->GetFloatingPositioners()) {
+                if (positioner->HasSelfBB()) boxes.push_back(positioner);
+            }
+        }
+        if (boxes.empty()) return;
+
+        int left = boxes.front()->GetSelfLeft();
+        int right = boxes.front()->GetSelfRight();
+        for (const BoundingBox *box : boxes) {
+            left = std::min(left, box->GetSelfLeft());
+            right = std::max(right, box->GetSelfRight());
+        }
+        m_drawingBBoxIndex.Reset(left, right, 4 * doc->GetDrawingUnit(100));
+        for (BoundingBox *box : boxes) {
+            m_drawingBBoxIndex.Add(
+                box, box->GetSelfLeft(), box->GetSelfRight(), box->GetSelfBottom(), box->GetSelfTop());
+        }
+    }
+
+    ArrayOfBoundingBoxes boxes;
+    m_drawingBBoxIndex.FindAt(x, y, boxes);
+
+    // Return the objects from the smallest box, which is usually the one expected
+    auto getArea = [](const BoundingBox *box) {
+        return (double)(box->GetSelfRight() - box->GetSelfLeft()) * (box->GetSelfTop() - box->GetSelfBottom());
+    };
+    std::stable_sort(boxes.begin(), boxes.end(),
+        [&getArea](const BoundingBox *box1, const BoundingBox *box2) { return getArea(box1) < getArea(box2); });
+    for (BoundingBox *box : boxes) {
+        Object *object = dynamic_cast<Object *>(box);
+        if (!object) {
+            FloatingPositioner *positioner = vrv_cast<FloatingPositioner *>(box);
+            assert(positioner);
+            object = positioner->GetObject();
+        }
+        if (std::find(objects.begin(), objects.end(), object) == objects.end()) objects.push_back(object);
+    }
+}
+
 void System::ConvertToCastOffMensuralSystem(Doc *doc, System *targetSystem)
 {
     assert(doc);
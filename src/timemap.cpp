@@ -38,12 +38,17 @@ void Timemap::Reset()
 }
 
 void Timemap::ToJson(std::string &output, bool includeRests, bool includeMeasures)
+{
+    jsonxx::Array timemap;
+    this->ToJson(timemap, includeRests, includeMeasures);
+    output = timemap.json();
+}
+
+void Timemap::ToJson(jsonxx::Array &timemap, bool includeRests, bool includeMeasures)
 {
     double currentTempo = -1000.0;
     double newTempo;
 
-    jsonxx::Array timemap;
-
     for (auto &[tstamp, entry] : m_map) {
         jsonxx::Object o;
         o << "tstamp" << tstamp;
@@ -91,7 +96,6 @@ void Timemap::ToJson(std::string &output, bool includeRests, bool includeMeasure
 
         timemap << o;
     }
-    output = timemap.json();
 }
 
 } // namespace vrv
@@ -9,10 +9,15 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <codecvt>
 #include <locale>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <thread>
 
 //----------------------------------------------------------------------------
 
@@ -35,13 +40,18 @@
 #include "nc.h"
 #include "neume.h"
 #include "note.h"
+#include "objectarena.h"
 #include "options.h"
 #include "page.h"
+#include "pages.h"
+#include "profiler.h"
 #include "runtimeclock.h"
 #include "score.h"
 #include "slur.h"
+#include "snapshot.h"
 #include "staff.h"
 #include "svgdevicecontext.h"
+#include "system.h"
 #include "vrv.h"
 
 //----------------------------------------------------------------------------
@@ -84,6 +94,12 @@ Toolkit::Toolkit(bool initFont)
 #ifndef NO_RUNTIME
     m_runtimeClock = NULL;
 #endif
+
+    m_profiler = NULL;
+
+    m_snapshotLayout = NULL;
+
+    m_doc.SetObjectArena(true);
 }
 
 Toolkit::~Toolkit()
@@ -108,6 +124,11 @@ Toolkit::~Toolkit()
         m_runtimeClock = NULL;
     }
 #endif
+    if (m_profiler) {
+        if (Profiler::GetActive() == m_profiler) Profiler::SetActive(NULL);
+        delete m_profiler;
+        m_profiler = NULL;
+    }
 }
 
 std::string Toolkit::GetResourcePath() const
@@ -170,6 +191,9 @@ bool Toolkit::SetOutputTo(std::string const &outputTo)
     else if (outputTo == "mei-facs") {
         m_outputTo = MEI;
     }
+    else if (outputTo == "snapshot") {
+        m_outputTo = MEI;
+    }
     else if (outputTo == "midi") {
         m_outputTo = MIDI;
     }
@@ -243,7 +267,7 @@ bool Toolkit::SetInputFrom(std::string const &inputFrom)
     return true;
 }
 
-FileFormat Toolkit::IdentifyInputFrom(const std::string &data)
+FileFormat Toolkit::IdentifyInputFrom(std::string_view data)
 {
 #ifdef MUSICXML_DEFAULT_HUMDRUM
     FileFormat musicxmlDefault = MUSICXMLHUM;
@@ -257,9 +281,9 @@ FileFormat Toolkit::IdentifyInputFrom(const std::string &data)
     if (data[0] == 0) {
         return UNKNOWN;
     }
-    std::string excerpt = data.substr(0, 2000);
-    std::string::size_type found = excerpt.find("Group memberships:");
-    if (found != std::string::npos) {
+    std::string_view excerpt = data.substr(0, 2000);
+    std::string_view::size_type found = excerpt.find("Group memberships:");
+    if (found != std::string_view::npos) {
         // MuseData may contain '@' as first character, so needs
         // to be checked before PAE identification.
         return MUSEDATAHUM;
@@ -282,7 +306,7 @@ FileFormat Toolkit::IdentifyInputFrom(const std::string &data)
         return UNKNOWN;
     }
     const int searchLimit = 600;
-    std::string initial = data.substr(0, searchLimit);
+    std::string initial(data.substr(0, searchLimit));
     if (data[0] == '<') {
         // <mei> == root node for standard organization of MEI data
         // <pages> == root node for pages organization of MEI data
@@ -321,68 +345,76 @@ bool Toolkit::LoadFile(const std::string &filename)
 {
     this->ResetLogBuffer();
 
-    if (this->IsUTF16(filename)) {
-        return this->LoadUTF16File(filename);
+    // The content is mapped and passed as a view to the importers without being copied
+    MemoryMappedFile file;
+    if (!file.Open(filename)) {
+        return false;
     }
-    if (this->IsZip(filename)) {
-        return this->LoadZipFile(filename);
+
+    if (this->IsUTF16(file.GetView())) {
+        return this->LoadUTF16Data(file.GetView());
+    }
+    if (this->IsZip(file.GetView())) {
+        return this->LoadZipBuffer(file.GetBytes(), file.GetSize());
+    }
+    if (Snapshot::IsSnapshot(file.GetView())) {
+        return this->LoadSnapshot(file.GetView());
     }
 
-    std::ifstream in(filename.c_str());
-    if (!in.is_open()) {
+    return this->LoadData(file.GetView(), false);
+}
+
+bool Toolkit::LoadSnapshot(std::string_view data)
+{
+    Snapshot snapshot;
+    if (!snapshot.Read(data)) {
+        LogError("The snapshot is invalid");
         return false;
     }
 
-    in.seekg(0, std::ios::end);
-    std::streamsize fileSize = (std::streamsize)in.tellg();
-    in.clear();
-    in.seekg(0, std::ios::beg);
+    // The layout can only be restored with the same version and options
+    std::vector<CastOffRecord> layout;
+    if (snapshot.GetSignature() == this->GetSnapshotSignature()) {
+        snapshot.GetLayout(layout);
+        m_snapshotLayout = &layout;
+    }
+    else {
+        LogWarning("The snapshot was saved with another version or other options - the layout is recalculated");
+    }
 
-    // read the file into the std::string:
-    std::string content(fileSize, 0);
-    in.read(&content[0], fileSize);
+    const FileFormat inputFrom = m_inputFrom;
+    m_inputFrom = MEI;
+    const bool success = this->LoadData(snapshot.GetMEI(), false);
+    m_inputFrom = inputFrom;
+    m_snapshotLayout = NULL;
 
-    return this->LoadData(content, false);
+    return success;
 }
 
-bool Toolkit::IsUTF16(const std::string &filename)
+std::string Toolkit::GetSnapshotSignature() const
 {
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
-        return false;
-    }
+    return this->GetVersion() + "\n" + this->GetOptions(false);
+}
 
-    char data[2];
-    memset(data, 0, 2);
-    fin.read(data, 2);
-    fin.close();
+bool Toolkit::IsUTF16(std::string_view data)
+{
+    if (data.size() < 2) return false;
 
-    if (memcmp(data, UTF_16_LE_BOM, 2) == 0) return true;
-    if (memcmp(data, UTF_16_BE_BOM, 2) == 0) return true;
+    if (memcmp(data.data(), UTF_16_LE_BOM, 2) == 0) return true;
+    if (memcmp(data.data(), UTF_16_BE_BOM, 2) == 0) return true;
 
     return false;
 }
 
-bool Toolkit::LoadUTF16File(const std::string &filename)
+bool Toolkit::LoadUTF16Data(std::string_view data)
 {
     /// Loading a UTF-16 file with basic conversion ot UTF-8
     /// This is called after checking if the file has a UTF-16 BOM
 
     LogWarning("The file seems to be UTF-16 - trying to convert to UTF-8");
 
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
-        return false;
-    }
-
-    fin.seekg(0, std::ios::end);
-    std::streamsize wfileSize = (std::streamsize)fin.tellg();
-    fin.clear();
-
-    fin.seekg(0, std::wios::beg);
-
-    std::u16string u16data((wfileSize / 2) + 1, '\0');
-    fin.read((char *)&u16data[0], wfileSize);
+    std::u16string u16data((data.size() / 2) + 1, '\0');
+    memcpy(&u16data[0], data.data(), data.size());
 
     // order of the bytes has to be flipped
     if (u16data.at(0) == u'\uFFFE') {
@@ -406,52 +438,21 @@ bool Toolkit::LoadUTF16File(const std::string &filename)
     return this->LoadData(utf8line, false);
 }
 
-bool Toolkit::IsZip(const std::string &filename)
+bool Toolkit::IsZip(std::string_view data)
 {
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
-        return false;
-    }
-
-    char data[4];
-    memset(data, 0, 4);
-    fin.read(data, 4);
-    fin.close();
+    if (data.size() < 4) return false;
 
-    if (memcmp(data, ZIP_SIGNATURE, 4) == 0) return true;
+    if (memcmp(data.data(), ZIP_SIGNATURE, 4) == 0) return true;
 
     return false;
 }
 
-bool Toolkit::LoadZipFile(const std::string &filename)
-{
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
-        return false;
-    }
-
-    fin.seekg(0, std::ios::end);
-    std::streamsize fileSize = (std::streamsize)fin.tellg();
-    fin.clear();
-    fin.seekg(0, std::wios::beg);
-
-    std::vector<unsigned char> bytes;
-    bytes.reserve(fileSize + 1);
-
-    unsigned char buffer;
-    while (fin.read((char *)&buffer, sizeof(unsigned char))) {
-        bytes.push_back(buffer);
-    }
-
-    return this->LoadZipData(bytes);
-}
-
-bool Toolkit::LoadZipData(const std::vector<unsigned char> &bytes)
+bool Toolkit::LoadZipBuffer(const unsigned char *data, size_t length)
 {
     this->ResetLogBuffer();
 #ifndef NO_MXL_SUPPORT
     ZipFileReader zipFileReader;
-    zipFileReader.LoadBytes(bytes);
+    zipFileReader.LoadBuffer(data, length);
 
     const std::string metaInf = "META-INF/container.xml";
     if (!zipFileReader.HasFile(metaInf)) {
@@ -482,13 +483,12 @@ bool Toolkit::LoadZipData(const std::vector<unsigned char> &bytes)
 bool Toolkit::LoadZipDataBase64(const std::string &data)
 {
     std::vector<unsigned char> bytes = Base64Decode(data);
-    return this->LoadZipData(bytes);
+    return this->LoadZipBuffer(bytes.data(), bytes.size());
 }
 
 bool Toolkit::LoadZipDataBuffer(const unsigned char *data, int length)
 {
-    std::vector<unsigned char> bytes(data, data + length);
-    return this->LoadZipData(bytes);
+    return this->LoadZipBuffer(data, (size_t)length);
 }
 
 bool Toolkit::LoadData(const std::string &data)
@@ -496,7 +496,7 @@ bool Toolkit::LoadData(const std::string &data)
     return this->LoadData(data, true);
 }
 
-bool Toolkit::LoadData(const std::string &data, bool resetLogBuffer)
+bool Toolkit::LoadData(std::string_view data, bool resetLogBuffer)
 {
     std::string newData;
     Input *input = NULL;
@@ -505,11 +505,14 @@ bool Toolkit::LoadData(const std::string &data, bool resetLogBuffer)
         this->ResetLogBuffer();
     }
 
+    // Allocate the objects in the arena of the doc, if any
+    ObjectArenaScope arenaScope(m_doc.GetObjectArena());
+
     m_doc.m_expansionMap.Reset();
 
     if (m_options->m_xmlIdChecksum.GetValue()) {
         crcInit();
-        unsigned int cr = crcFast((unsigned char *)data.c_str(), (int)data.size());
+        unsigned int cr = crcFast((const unsigned char *)data.data(), (int)data.size());
         Object::SeedID(cr);
     }
 
@@ -558,7 +561,7 @@ bool Toolkit::LoadData(const std::string &data, bool resetLogBuffer)
             input->SetOutputFormat("humdrum");
         }
 
-        if (!input->Import(data)) {
+        if (!input->ImportBuffer(data)) {
             LogError("Error importing Humdrum data (1)");
             delete input;
             return false;
@@ -585,7 +588,7 @@ bool Toolkit::LoadData(const std::string &data, bool resetLogBuffer)
             tempinput->SetOutputFormat("humdrum");
         }
 
-        if (!tempinput->Import(data)) {
+        if (!tempinput->ImportBuffer(data)) {
             LogError("Error importing Humdrum data (1)");
             delete tempinput;
             return false;
@@ -621,7 +624,7 @@ bool Toolkit::LoadData(const std::string &data, bool resetLogBuffer)
         // This is the indirect converter from MusicXML to MEI using iohumdrum:
         hum::Tool_musicxml2hum converter;
         pugi::xml_document xmlfile;
-        xmlfile.load_string(data.c_str());
+        xmlfile.load_buffer(data.data(), data.size(), pugi::parse_default, pugi::encoding_utf8);
         stringstream conversion;
 
         LogRedirectStart();
@@ -655,7 +658,7 @@ bool Toolkit::LoadData(const std::string &data, bool resetLogBuffer)
     }
 
     else if (inputFormat == MEIHUM) {
-        ConvertMEIToHumdrum(data);
+        ConvertMEIToHumdrum(std::string(data));
 
         // Now convert Humdrum into MEI:
         std::string conversion = this->GetHumdrumBuffer();
@@ -680,7 +683,7 @@ bool Toolkit::LoadData(const std::string &data, bool resetLogBuffer)
         stringstream conversion;
 
         LogRedirectStart();
-        bool status = converter.convertString(conversion, data);
+        bool status = converter.convertString(conversion, std::string(data));
         LogRedirectStop();
         if (!status) {
             LogWarning("Problem converting MuseData to Humdrum (see warning above this line for possible reasons");
@@ -715,7 +718,7 @@ bool Toolkit::LoadData(const std::string &data, bool resetLogBuffer)
         std::stringstream conversion;
 
         LogRedirectStart();
-        bool status = converter.convert(conversion, data);
+        bool status = converter.convert(conversion, std::string(data));
         LogRedirectStop();
         if (!status) {
             LogWarning("Problem converting EsAC to Humdrum (see warning above this line for possible reasons");
@@ -757,7 +760,7 @@ bool Toolkit::LoadData(const std::string &data, bool resetLogBuffer)
 
     // load the file
     if (inputFormat != HUMDRUM) {
-        if (!input->Import(newData.size() ? newData : data)) {
+        if (!(newData.size() ? input->Import(newData) : input->ImportBuffer(data))) {
             LogError("Error importing data");
             delete input;
             return false;
@@ -819,6 +822,11 @@ bool Toolkit::LoadData(const std::string &data, bool resetLogBuffer)
         breaks = (m_doc.HasFacsimile()) ? BREAKS_encoded : BREAKS_none;
     }
 
+    // Restore the layout of a snapshot, or cast off the document normally if it does not match
+    if ((breaks != BREAKS_none) && m_snapshotLayout && m_doc.CastOffLayoutDoc(*m_snapshotLayout)) {
+        breaks = BREAKS_none;
+    }
+
     if (breaks != BREAKS_none) {
         if (input->GetLayoutInformation() == LAYOUT_ENCODED
             && (breaks == BREAKS_encoded || breaks == BREAKS_line || breaks == BREAKS_smart)) {
@@ -1001,6 +1009,38 @@ bool Toolkit::SaveFile(const std::string &filename, const std::string &jsonOptio
     return true;
 }
 
+bool Toolkit::SaveSnapshotFile(const std::string &filename)
+{
+    if (this->GetPageCount() == 0) {
+        LogWarning("No data loaded");
+        return false;
+    }
+    if (m_doc.HasSelection()) {
+        LogError("A snapshot cannot be saved with a selection");
+        return false;
+    }
+    // The MEI would be transposed or expanded again when loading the snapshot
+    if (m_options->m_transpose.IsSet() || m_options->m_transposeMdiv.IsSet()
+        || m_options->m_transposeToSoundingPitch.IsSet() || m_options->m_expand.IsSet()) {
+        LogError("A snapshot cannot be saved with transposition or expansion options");
+        return false;
+    }
+
+    const std::string mei = this->GetMEI("{\"scoreBased\": true}");
+    if (mei.empty()) {
+        return false;
+    }
+
+    std::vector<CastOffRecord> layout;
+    m_doc.GetCastOffLayout(layout);
+
+    if (!Snapshot::Write(filename, this->GetSnapshotSignature(), layout, mei)) {
+        LogError("Unable to write the snapshot to %s", filename.c_str());
+        return false;
+    }
+    return true;
+}
+
 std::string Toolkit::GetOptions() const
 {
     return this->GetOptions(false);
@@ -1358,6 +1398,11 @@ std::string Toolkit::GetOptionUsageString() const
 }
 
 std::string Toolkit::GetElementAttr(const std::string &xmlId)
+{
+    return this->GetElementAttrObj(xmlId).json();
+}
+
+jsonxx::Object Toolkit::GetElementAttrObj(const std::string &xmlId)
 {
     jsonxx::Object o;
 
@@ -1406,7 +1451,7 @@ std::string Toolkit::GetElementAttr(const std::string &xmlId)
     // If not found at all
     if (!element) {
         LogWarning("Element '%s' not found", xmlId.c_str());
-        return o.json();
+        return o;
     }
 
     // Fill the attribute array (pair of std::string) by looking at attributes for all available MEI modules
@@ -1419,7 +1464,7 @@ std::string Toolkit::GetElementAttr(const std::string &xmlId)
         o << (*iter).first << (*iter).second;
         // LogInfo("Element %s - %s", (*iter).first.c_str(), (*iter).second.c_str());
     }
-    return o.json();
+    return o;
 }
 
 std::string Toolkit::GetNotatedIdForElement(const std::string &xmlId)
@@ -1479,6 +1524,42 @@ void Toolkit::ResetXmlIdSeed(int seed)
     Object::SeedID(m_options->m_xmlIdSeed.GetValue());
 }
 
+void Toolkit::StartProfiling()
+{
+    if (!m_profiler) {
+        m_profiler = new Profiler();
+    }
+    else {
+        m_profiler->Reset();
+    }
+    Profiler::SetActive(m_profiler);
+}
+
+void Toolkit::StopProfiling()
+{
+    if (m_profiler && (Profiler::GetActive() == m_profiler)) {
+        Profiler::SetActive(NULL);
+    }
+}
+
+std::string Toolkit::GetProfile() const
+{
+    if (!m_profiler) {
+        LogWarning("No profile available. Please call 'StartProfiling' to create one.");
+        return "{}";
+    }
+    return m_profiler->GetProfileJSON();
+}
+
+std::string Toolkit::GetProfileTrace() const
+{
+    if (!m_profiler) {
+        LogWarning("No profile available. Please call 'StartProfiling' to create one.");
+        return "{}";
+    }
+    return m_profiler->GetTraceJSON();
+}
+
 void Toolkit::ResetLogBuffer()
 {
     logBuffer.clear();
@@ -1536,6 +1617,8 @@ void Toolkit::RedoLayout(const std::string &jsonOptions)
         return;
     }
 
+    ObjectArenaScope arenaScope(m_doc.GetObjectArena());
+
     if (m_docSelection.m_isPending) {
         m_doc.InitSelectionDoc(m_docSelection, resetCache);
     }
@@ -1543,6 +1626,69 @@ void Toolkit::RedoLayout(const std::string &jsonOptions)
         m_doc.UnCastOffDoc(resetCache);
     }
 
+    this->CastOffDocWithBreaks();
+}
+
+std::string Toolkit::RedoEditedLayout()
+{
+    this->ResetLogBuffer();
+
+    jsonxx::Array changedPages;
+
+    if ((this->GetPageCount() == 0) || m_doc.IsTranscription() || m_doc.IsFacs()) {
+        LogWarning("No data to re-layout");
+        return changedPages.json();
+    }
+
+    ObjectArenaScope arenaScope(m_doc.GetObjectArena());
+
+    // The first and last child of each system, for finding the pages with a different content
+    auto getPageSystems = [this]() {
+        std::vector<ArrayOfConstObjects> pageSystems;
+        for (const Object *page : m_doc.GetPages()->GetChildren()) {
+            ArrayOfConstObjects &systems = pageSystems.emplace_back();
+            for (const Object *child : page->GetChildren()) {
+                if (!child->Is(SYSTEM) || !child->GetChildCount()) continue;
+                systems.push_back(child->GetChild(0));
+                systems.push_back(child->GetChild(child->GetChildCount() - 1));
+            }
+        }
+        return pageSystems;
+    };
+
+    const std::vector<ArrayOfConstObjects> previousPageSystems = getPageSystems();
+    std::vector<bool> dirtyPages;
+    for (const Object *page : m_doc.GetPages()->GetChildren()) {
+        ListOfConstObjects systems = page->FindAllDescendantsByType(SYSTEM, false, 1);
+        dirtyPages.push_back(std::any_of(systems.begin(), systems.end(),
+            [](const Object *system) { return vrv_cast<const System *>(system)->HasDirtyMeasures(); }));
+    }
+    if (std::none_of(dirtyPages.begin(), dirtyPages.end(), [](bool isDirty) { return isDirty; })) {
+        return changedPages.json();
+    }
+
+    const bool isIncremental = !m_docSelection.m_isPending && m_doc.LayOutDirtyMeasures();
+    if (isIncremental) {
+        m_doc.UnCastOffDoc(false);
+        this->CastOffDocWithBreaks();
+    }
+    else {
+        this->RedoLayout();
+    }
+
+    const std::vector<ArrayOfConstObjects> pageSystems = getPageSystems();
+    for (int i = 0; i < (int)pageSystems.size(); ++i) {
+        if (!isIncremental || (i >= (int)previousPageSystems.size()) || (pageSystems.at(i) != previousPageSystems.at(i))
+            || dirtyPages.at(i)) {
+            changedPages << i + 1;
+        }
+    }
+
+    return changedPages.json();
+}
+
+void Toolkit::CastOffDocWithBreaks()
+{
     if (m_options->m_breaks.GetValue() == BREAKS_line) {
         m_doc.CastOffLineDoc();
     }
@@ -1584,6 +1730,14 @@ bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
     // Get the current system for the SVG clipping size
     m_view.SetPage(pageNo);
 
+    // render the page
+    this->DrawPageToDeviceContext(m_view, deviceContext);
+
+    return true;
+}
+
+void Toolkit::DrawPageToDeviceContext(View &view, DeviceContext *deviceContext)
+{
     // Adjusting page width and height according to the options
     int width = m_options->m_pageWidth.GetUnfactoredValue();
     int height = m_options->m_pageHeight.GetUnfactoredValue();
@@ -1591,12 +1745,12 @@ bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
     bool adjustHeight = m_options->m_adjustPageHeight.GetValue();
     bool adjustWidth = m_options->m_adjustPageWidth.GetValue();
 
-    if (adjustWidth || (breaks == BREAKS_none)) width = m_doc.GetAdjustedDrawingPageWidth();
-    if (adjustHeight || (breaks == BREAKS_none)) height = m_doc.GetAdjustedDrawingPageHeight();
+    if (adjustWidth || (breaks == BREAKS_none)) width = view.GetAdjustedDrawingPageWidth();
+    if (adjustHeight || (breaks == BREAKS_none)) height = view.GetAdjustedDrawingPageHeight();
 
     if (m_doc.IsTranscription()) {
-        width = m_doc.GetAdjustedDrawingPageWidth();
-        height = m_doc.GetAdjustedDrawingPageHeight();
+        width = view.GetAdjustedDrawingPageWidth();
+        height = view.GetAdjustedDrawingPageHeight();
     }
 
     // set dimensions
@@ -1616,17 +1770,14 @@ bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
     deviceContext->SetUserScale(userScale, userScale);
     deviceContext->SetWidth(width);
     deviceContext->SetHeight(height);
-    deviceContext->SetViewBoxFactor(m_view.GetPPUFactor());
+    deviceContext->SetViewBoxFactor(view.GetPPUFactor());
 
     if (m_doc.IsFacs()) {
         deviceContext->SetWidth(m_doc.GetFacsimile()->GetMaxX());
         deviceContext->SetHeight(m_doc.GetFacsimile()->GetMaxY());
     }
 
-    // render the page
-    m_view.DrawCurrentPage(deviceContext, false);
-
-    return true;
+    view.DrawCurrentPage(deviceContext, false);
 }
 
 std::string Toolkit::RenderData(const std::string &data, const std::string &jsonOptions)
@@ -1645,6 +1796,87 @@ std::string Toolkit::RenderToSVG(int pageNo, bool xmlDeclaration)
     // Create the SVG object, h & w come from the system
     // We will need to set the size of the page after having drawn it depending on the options
     SvgDeviceContext svg;
+    this->InitSvgDeviceContext(svg);
+
+    // render the page
+    this->RenderToDeviceContext(pageNo, &svg);
+
+    std::string out_str = svg.GetStringSVG(xmlDeclaration);
+    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
+    return out_str;
+}
+
+std::vector<std::string> Toolkit::RenderAllToSVG(int threads, bool xmlDeclaration)
+{
+    this->ResetLogBuffer();
+
+    const int pageCount = this->GetPageCount();
+    std::vector<std::string> svgPages(pageCount);
+
+    if (threads <= 0) threads = std::thread::hardware_concurrency();
+    threads = std::min(threads, pageCount);
+#ifdef __EMSCRIPTEN__
+    threads = 1;
+#endif
+
+    // Drawing concurrently relies on the drawing sizes of the doc being the same for all pages
+    bool concurrent = (threads > 1) && !m_doc.IsTranscription() && !m_doc.IsFacs();
+    for (int i = 0; concurrent && (i < pageCount); ++i) {
+        const Page *page = vrv_cast<const Page *>(m_doc.GetPages()->GetChild(i));
+        assert(page);
+        if (page->m_pageHeight != -1) concurrent = false;
+    }
+
+    if (!concurrent) {
+        for (int i = 0; i < pageCount; ++i) {
+            svgPages.at(i) = this->RenderToSVG(i + 1, xmlDeclaration);
+        }
+        return svgPages;
+    }
+
+    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+
+    // The layout changes the document and has to be done for all pages before drawing them
+    // The SVG objects are created here too since they get an ID for the glyphs as in RenderToSVG
+    std::vector<std::unique_ptr<SvgDeviceContext>> svgDeviceContexts;
+    for (int i = 0; i < pageCount; ++i) {
+        svgDeviceContexts.push_back(std::make_unique<SvgDeviceContext>());
+        m_view.SetPage(i);
+    }
+
+    std::mutex mutex;
+    std::atomic<int> nextPageIdx = 0;
+    auto drawPages = [&]() {
+        View view;
+        view.SetDoc(&m_doc);
+        view.SetConcurrentDrawing(&mutex);
+        int pageIdx;
+        while ((pageIdx = nextPageIdx++) < pageCount) {
+            std::unique_ptr<SvgDeviceContext> &svg = svgDeviceContexts.at(pageIdx);
+            this->InitSvgDeviceContext(*svg);
+            view.SetPage(pageIdx, false);
+            this->DrawPageToDeviceContext(view, svg.get());
+            svgPages.at(pageIdx) = svg->GetStringSVG(xmlDeclaration);
+            svg.reset();
+        }
+    };
+
+    // The current thread draws pages too
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i) {
+        workers.emplace_back(drawPages);
+    }
+    drawPages();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
+    return svgPages;
+}
+
+void Toolkit::InitSvgDeviceContext(SvgDeviceContext &svg)
+{
     svg.SetResources(&m_doc.GetResources());
 
     int indent = (m_options->m_outputIndentTab.GetValue()) ? -1 : m_options->m_outputIndent.GetValue();
@@ -1677,13 +1909,6 @@ std::string Toolkit::RenderToSVG(int pageNo, bool xmlDeclaration)
     svg.SetRemoveXlink(m_options->m_svgRemoveXlink.GetValue());
     svg.SetAdditionalAttributes(m_options->m_svgAdditionalAttribute.GetValue());
     svg.SetSmuflTextFont((option_SMUFLTEXTFONT)m_options->m_smuflTextFont.GetValue());
-
-    // render the page
-    this->RenderToDeviceContext(pageNo, &svg);
-
-    std::string out_str = svg.GetStringSVG(xmlDeclaration);
-    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
-    return out_str;
 }
 
 bool Toolkit::RenderToSVGFile(const std::string &filename, int pageNo)
@@ -1780,6 +2005,14 @@ bool Toolkit::RenderToPAEFile(const std::string &filename)
 }
 
 std::string Toolkit::RenderToTimemap(const std::string &jsonOptions)
+{
+    jsonxx::Array timemap = this->RenderToTimemapObj(jsonOptions);
+    // The timemap could not be calculated
+    if (!m_doc.HasTimemap()) return "{}";
+    return timemap.json();
+}
+
+jsonxx::Array Toolkit::RenderToTimemapObj(const std::string &jsonOptions)
 {
     bool includeMeasures = false;
     bool includeRests = false;
@@ -1800,9 +2033,9 @@ std::string Toolkit::RenderToTimemap(const std::string &jsonOptions)
 
     this->ResetLogBuffer();
 
-    std::string output;
-    m_doc.ExportTimemap(output, includeRests, includeMeasures);
-    return output;
+    jsonxx::Array timemap;
+    m_doc.ExportTimemap(timemap, includeRests, includeMeasures);
+    return timemap;
 }
 
 std::string Toolkit::RenderToExpansionMap()
@@ -1815,6 +2048,11 @@ std::string Toolkit::RenderToExpansionMap()
 }
 
 std::string Toolkit::GetElementsAtTime(int millisec)
+{
+    return this->GetElementsAtTimeObj(millisec).json();
+}
+
+jsonxx::Object Toolkit::GetElementsAtTimeObj(int millisec)
 {
     this->ResetLogBuffer();
 
@@ -1833,7 +2071,7 @@ std::string Toolkit::GetElementsAtTime(int millisec)
     Measure *measure = dynamic_cast<Measure *>(m_doc.FindDescendantByComparison(&matchMeasureTime));
 
     if (!measure) {
-        return o.json();
+        return o;
     }
 
     int repeat = measure->EnclosesTime(millisec);
@@ -1874,7 +2112,39 @@ std::string Toolkit::GetElementsAtTime(int millisec)
     o << "page" << pageNo;
     o << "measure" << measure->GetID();
 
-    return o.json();
+    return o;
+}
+
+std::string Toolkit::GetElementsAtPoint(int pageNo, int x, int y)
+{
+    this->ResetLogBuffer();
+
+    jsonxx::Array elementArray;
+
+    if ((pageNo <= 0) || (pageNo > this->GetPageCount())) {
+        LogWarning("Page %d does not exist", pageNo);
+        return elementArray.json();
+    }
+
+    ObjectArenaScope arenaScope(m_doc.GetObjectArena());
+
+    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+
+    // Lay out the page if necessary, as when rendering it
+    m_view.SetPage(pageNo - 1);
+    Page *page = m_doc.GetDrawingPage();
+    assert(page);
+
+    // The bounding boxes are in logical coordinates with the y axis going up
+    ListOfObjects objects;
+    page->FindAllAtPoint(x, m_doc.m_drawingPageContentHeight - y, objects);
+
+    for (Object *object : objects) {
+        elementArray << object->GetID();
+    }
+
+    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
+    return elementArray.json();
 }
 
 bool Toolkit::RenderToMIDIFile(const std::string &filename)
@@ -1929,6 +2199,13 @@ std::string Toolkit::GetDescriptiveFeatures(const std::string &options)
     return output;
 }
 
+jsonxx::Object Toolkit::GetDescriptiveFeaturesObj(const std::string &options)
+{
+    jsonxx::Object features;
+    m_doc.ExportFeatures(features, options);
+    return features;
+}
+
 int Toolkit::GetPageWithElement(const std::string &xmlId)
 {
     Object *element = m_doc.FindDescendantByID(xmlId);
@@ -1992,6 +2269,11 @@ int Toolkit::GetTimeForElement(const std::string &xmlId)
 }
 
 std::string Toolkit::GetTimesForElement(const std::string &xmlId)
+{
+    return this->GetTimesForElementObj(xmlId).json();
+}
+
+jsonxx::Object Toolkit::GetTimesForElementObj(const std::string &xmlId)
 {
     this->ResetLogBuffer();
 
@@ -2000,7 +2282,7 @@ std::string Toolkit::GetTimesForElement(const std::string &xmlId)
 
     if (!element) {
         LogWarning("Element '%s' not found", xmlId.c_str());
-        return o.json();
+        return o;
     }
 
     jsonxx::Array scoreTimeOnset;
@@ -2016,7 +2298,7 @@ std::string Toolkit::GetTimesForElement(const std::string &xmlId)
     }
     if (!m_doc.HasTimemap()) {
         LogWarning("Calculation of MIDI timemap failed, time value is invalid.");
-        return o.json();
+        return o;
     }
     if (element->Is(NOTE)) {
 
@@ -2042,10 +2324,15 @@ std::string Toolkit::GetTimesForElement(const std::string &xmlId)
         o << "realTimeOnsetMilliseconds" << realTimeOnsetMilliseconds;
         o << "realTimeOffsetMilliseconds" << realTimeOffsetMilliseconds;
     }
-    return o.json();
+    return o;
 }
 
 std::string Toolkit::GetMIDIValuesForElement(const std::string &xmlId)
+{
+    return this->GetMIDIValuesForElementObj(xmlId).json();
+}
+
+jsonxx::Object Toolkit::GetMIDIValuesForElementObj(const std::string &xmlId)
 {
     this->ResetLogBuffer();
 
@@ -2054,7 +2341,7 @@ std::string Toolkit::GetMIDIValuesForElement(const std::string &xmlId)
 
     if (!element) {
         LogWarning("Element '%s' not found", xmlId.c_str());
-        return o.json();
+        return o;
     }
 
     if (element->Is(NOTE)) {
@@ -2064,7 +2351,7 @@ std::string Toolkit::GetMIDIValuesForElement(const std::string &xmlId)
         }
         if (!m_doc.HasTimemap()) {
             LogWarning("Calculation of MIDI timemap failed, time value is invalid.");
-            return o.json();
+            return o;
         }
         Note *note = vrv_cast<Note *>(element);
         assert(note);
@@ -2075,7 +2362,7 @@ std::string Toolkit::GetMIDIValuesForElement(const std::string &xmlId)
         o << "pitch" << pitchOfElement;
         o << "duration" << durationOfElement;
     }
-    return o.json();
+    return o;
 }
 
 void Toolkit::SetHumdrumBuffer(const char *data)
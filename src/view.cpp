@@ -16,6 +16,7 @@
 
 #include "doc.h"
 #include "page.h"
+#include "pages.h"
 #include "vrv.h"
 
 namespace vrv {
@@ -30,6 +31,7 @@ View::View()
     m_options = NULL;
     m_pageIdx = 0;
     m_slurHandling = SlurHandling::Initialize;
+    m_concurrentMutex = NULL;
 
     m_currentColor = AxNONE;
     m_currentElement = NULL;
@@ -68,9 +70,11 @@ void View::SetPage(int pageIdx, bool doLayout)
     assert(m_doc->HasPage(pageIdx));
 
     m_pageIdx = pageIdx;
-    m_currentPage = m_doc->SetDrawingPage(pageIdx);
+    m_currentPage = this->GetPageToDraw();
 
     if (doLayout) {
+        // Laying out a page cannot be done concurrently
+        assert(!m_concurrentMutex);
         m_doc->ScoreDefSetCurrentDoc();
         // if we once deal with multiple views, it would be better
         // to redo the layout only when necessary?
@@ -92,6 +96,15 @@ void View::SetPage(int pageIdx, bool doLayout)
     DoRefresh();
 }
 
+Page *View::GetPageToDraw()
+{
+    // Do not change the drawing page of the document since other views are drawing concurrently
+    if (m_concurrentMutex) {
+        return vrv_cast<Page *>(m_doc->GetPages()->GetChild(m_pageIdx));
+    }
+    return m_doc->SetDrawingPage(m_pageIdx);
+}
+
 bool View::HasNext(bool forward)
 {
     if (forward) return (m_doc && (m_doc->HasPage(m_pageIdx + 1)));
@@ -278,6 +278,12 @@ void View::DrawTimeSpanningElement(DeviceContext *dc, Object *element, System *s
         }
     }
 
+    // Elements across systems can also be drawn on another page - lock when drawing concurrently
+    std::unique_lock<std::mutex> lock;
+    if (m_concurrentMutex && (spanningType != SPANNING_START_END)) {
+        lock = std::unique_lock<std::mutex>(*m_concurrentMutex);
+    }
+
     int startRadius = 0;
     if (!start->Is(TIMESTAMP_ATTR)) {
         startRadius = start->GetDrawingRadius(m_doc);
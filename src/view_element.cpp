@@ -18,9 +18,11 @@
 
 #include "accid.h"
 #include "artic.h"
+#include "bboxdevicecontext.h"
 #include "beam.h"
 #include "beatrpt.h"
 #include "btrem.h"
+#include "calcbboxfunctor.h"
 #include "chord.h"
 #include "clef.h"
 #include "custos.h"
@@ -76,6 +78,10 @@ void View::DrawLayerElement(DeviceContext *dc, LayerElement *element, Layer *lay
         return;
     }
 
+    if (dc->Is(BBOX_DEVICE_CONTEXT) && (m_options->m_boundingBoxes.GetValue() != BOUNDINGBOXES_draw)) {
+        if (this->CalcLayerElementBBox(dc, element, layer, staff, measure)) return;
+    }
+
     int previousColor = m_currentColor;
 
     if (element == m_currentElement) {
@@ -232,6 +238,52 @@ void View::DrawLayerElement(DeviceContext *dc, LayerElement *element, Layer *lay
     m_currentColor = previousColor;
 }
 
+bool View::CalcLayerElementBBox(DeviceContext *dc, LayerElement *element, Layer *layer, Staff *staff, Measure *measure)
+{
+    assert(dc && dc->Is(BBOX_DEVICE_CONTEXT));
+    assert(element);
+    assert(layer);
+    assert(staff);
+    assert(measure);
+
+    BBoxDeviceContext *bBoxDC = vrv_cast<BBoxDeviceContext *>(dc);
+    assert(bBoxDC);
+
+    const bool check = (m_options->m_boundingBoxes.GetValue() == BOUNDINGBOXES_check);
+
+    CalcBBoxFunctor calcBBox(m_doc, staff);
+    calcBBox.SetCheck(check);
+    element->Process(calcBBox);
+
+    if (!calcBBox.IsCalculated()) return false;
+
+    if (check) {
+        // Draw the element and compare the values
+        if (element->Is({ CHORD, NOTE, REST })) {
+            this->DrawDurationElement(dc, element, layer, staff, measure);
+        }
+        else if (element->Is(ACCID)) {
+            this->DrawAccid(dc, element, layer, staff, measure);
+        }
+        else if (element->Is(ARTIC)) {
+            this->DrawArtic(dc, element, layer, staff, measure);
+        }
+        else if (element->Is(DOTS)) {
+            this->DrawDots(dc, element, layer, staff, measure);
+        }
+        else if (element->Is(FLAG)) {
+            this->DrawFlag(dc, element, layer, staff, measure);
+        }
+        else if (element->Is(STEM)) {
+            this->DrawStem(dc, element, layer, staff, measure);
+        }
+        calcBBox.CheckBoundingBoxes();
+        return true;
+    }
+
+    return bBoxDC->UpdateWithContentBB(element);
+}
+
 //----------------------------------------------------------------------------
 // View - LayerElement
 //----------------------------------------------------------------------------
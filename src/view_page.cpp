@@ -68,7 +68,7 @@ void View::DrawCurrentPage(DeviceContext *dc, bool background)
     const bool dcHasResources = dc->HasResources();
     if (!dcHasResources) dc->SetResources(&m_doc->GetResources());
 
-    m_currentPage = m_doc->SetDrawingPage(m_pageIdx);
+    m_currentPage = this->GetPageToDraw();
 
     // Keep the width of the initial scoreDef
     SetScoreDefDrawingWidth(dc, &m_currentPage->m_drawingScoreDef);
@@ -77,8 +77,8 @@ void View::DrawCurrentPage(DeviceContext *dc, bool background)
     // The page one has previously been set by the ScoreDefSetCurrentFunctor
     m_drawingScoreDef = m_currentPage->m_drawingScoreDef;
 
-    if ((m_doc->GetAdjustedDrawingPageHeight() > dc->GetHeight()) && m_options->m_shrinkToFit.GetValue()) {
-        dc->SetContentHeight(m_doc->GetAdjustedDrawingPageHeight());
+    if ((this->GetAdjustedDrawingPageHeight() > dc->GetHeight()) && m_options->m_shrinkToFit.GetValue()) {
+        dc->SetContentHeight(this->GetAdjustedDrawingPageHeight());
     }
     else {
         dc->SetContentHeight(dc->GetHeight());
@@ -120,6 +120,24 @@ double View::GetPPUFactor() const
     return m_currentPage->GetPPUFactor();
 }
 
+int View::GetAdjustedDrawingPageWidth() const
+{
+    assert(m_currentPage);
+
+    return m_doc->GetAdjustedDrawingPageWidth(m_currentPage);
+}
+
+int View::GetAdjustedDrawingPageHeight() const
+{
+    assert(m_currentPage);
+
+    // The height includes the one of the footer that is shared with the pages drawn concurrently
+    std::unique_lock<std::mutex> lock;
+    if (m_concurrentMutex) lock = std::unique_lock<std::mutex>(*m_concurrentMutex);
+
+    return m_doc->GetAdjustedDrawingPageHeight(m_currentPage);
+}
+
 void View::SetScoreDefDrawingWidth(DeviceContext *dc, ScoreDef *scoreDef)
 {
     assert(dc);
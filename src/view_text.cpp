@@ -645,12 +645,18 @@ void View::DrawRunningElements(DeviceContext *dc, Page *page)
         if (!bBoxDC->UpdateVerticalValues()) return;
     }
 
+    // Running elements are shared by the pages - when drawing concurrently, we need to set the page ourselves
+    std::unique_lock<std::mutex> lock;
+    if (m_concurrentMutex) lock = std::unique_lock<std::mutex>(*m_concurrentMutex);
+
     RunningElement *header = page->GetHeader();
     if (header) {
+        if (m_concurrentMutex) header->SetDrawingPage(page);
         this->DrawTextLayoutElement(dc, header);
     }
     RunningElement *footer = page->GetFooter();
     if (footer) {
+        if (m_concurrentMutex) footer->SetDrawingPage(page);
         this->DrawTextLayoutElement(dc, footer);
     }
 }
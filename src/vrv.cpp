@@ -15,6 +15,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <locale>
+#include <mutex>
 #include <regex>
 #include <sstream>
 #include <vector>
@@ -71,6 +72,9 @@ bool loggingToBuffer = false;
 
 std::vector<std::string> logBuffer;
 
+/** For logging to the buffer from concurrent drawing threads */
+static std::mutex logBufferMutex;
+
 void LogElapsedTimeStart()
 {
     gettimeofday(&start, NULL);
@@ -139,6 +143,7 @@ void LogWarning(const char *fmt, ...)
 void LogString(std::string message, LogLevel level)
 {
     if (loggingToBuffer) {
+        const std::lock_guard<std::mutex> lock(logBufferMutex);
         if (LogBufferContains(message)) return;
         logBuffer.push_back(message);
     }
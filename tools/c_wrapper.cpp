@@ -9,6 +9,10 @@
 #include "toolkit.h"
 #include "vrv.h"
 
+//----------------------------------------------------------------------------
+
+#include "jsonxx.h"
+
 using namespace std;
 using namespace vrv;
 
@@ -94,6 +98,13 @@ const char *vrvToolkit_getElementAttr(void *tkPtr, const char *xmlId)
     return tk->GetCString();
 }
 
+const char *vrvToolkit_getElementsAtPoint(void *tkPtr, int pageNo, int x, int y)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetElementsAtPoint(pageNo, x, y));
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_getElementsAtTime(void *tkPtr, int millisec)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -205,6 +216,20 @@ int vrvToolkit_getPageWithElement(void *tkPtr, const char *xmlId)
     return tk->GetPageWithElement(xmlId);
 }
 
+const char *vrvToolkit_getProfile(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetProfile());
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_getProfileTrace(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetProfileTrace());
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_getResourcePath(void *tkPtr)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -262,6 +287,13 @@ bool vrvToolkit_loadZipDataBuffer(void *tkPtr, const unsigned char *data, int le
     return tk->LoadZipDataBuffer(data, length);
 }
 
+const char *vrvToolkit_redoEditedLayout(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->RedoEditedLayout());
+    return tk->GetCString();
+}
+
 void vrvToolkit_redoLayout(void *tkPtr, const char *c_options)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -274,6 +306,17 @@ void vrvToolkit_redoPagePitchPosLayout(void *tkPtr)
     tk->RedoPagePitchPosLayout();
 }
 
+const char *vrvToolkit_renderAllToSVG(void *tkPtr, int threads, bool xmlDeclaration)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    jsonxx::Array svgPages;
+    for (const std::string &svg : tk->RenderAllToSVG(threads, xmlDeclaration)) {
+        svgPages << svg;
+    }
+    tk->SetCString(svgPages.json());
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_renderData(void *tkPtr, const char *data, const char *options)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -364,6 +407,12 @@ bool vrvToolkit_saveFile(void *tkPtr, const char *filename, const char *c_option
     return tk->SaveFile(filename, c_options);
 }
 
+bool vrvToolkit_saveSnapshotFile(void *tkPtr, const char *filename)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->SaveSnapshotFile(filename);
+}
+
 bool vrvToolkit_select(void *tkPtr, const char *selection)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -400,6 +449,18 @@ bool vrvToolkit_setScale(void *tkPtr, int scale)
     return tk->SetScale(scale);
 }
 
+void vrvToolkit_startProfiling(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->StartProfiling();
+}
+
+void vrvToolkit_stopProfiling(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->StopProfiling();
+}
+
 const char *vrvToolkit_validatePAE(void *tkPtr, const char *data)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
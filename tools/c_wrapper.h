@@ -26,6 +26,7 @@ const char *vrvToolkit_getAvailableOptions(void *tkPtr);
 const char *vrvToolkit_getDefaultOptions(void *tkPtr);
 const char *vrvToolkit_getDescriptiveFeatures(void *tkPtr, const char *options);
 const char *vrvToolkit_getElementAttr(void *tkPtr, const char *xmlId);
+const char *vrvToolkit_getElementsAtPoint(void *tkPtr, int pageNo, int x, int y);
 const char *vrvToolkit_getElementsAtTime(void *tkPtr, int millisec);
 const char *vrvToolkit_getExpansionIdsForElement(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getHumdrum(void *tkPtr);
@@ -42,6 +43,8 @@ const char *vrvToolkit_getOptions(void *tkPtr);
 const char *vrvToolkit_getOptionUsageString(void *tkPtr);
 int vrvToolkit_getPageCount(void *tkPtr);
 int vrvToolkit_getPageWithElement(void *tkPtr, const char *xmlId);
+const char *vrvToolkit_getProfile(void *tkPtr);
+const char *vrvToolkit_getProfileTrace(void *tkPtr);
 const char *vrvToolkit_getResourcePath(void *tkPtr);
 int vrvToolkit_getScale(void *tkPtr);
 double vrvToolkit_getTimeForElement(void *tkPtr, const char *xmlId);
@@ -51,8 +54,10 @@ bool vrvToolkit_loadData(void *tkPtr, const char *data);
 bool vrvToolkit_loadFile(void *tkPtr, const char *filename);
 bool vrvToolkit_loadZipDataBase64(void *tkPtr, const char *data);
 bool vrvToolkit_loadZipDataBuffer(void *tkPtr, const unsigned char *data, int length);
+const char *vrvToolkit_redoEditedLayout(void *tkPtr);
 void vrvToolkit_redoLayout(void *tkPtr, const char *c_options);
 void vrvToolkit_redoPagePitchPosLayout(void *tkPtr);
+const char *vrvToolkit_renderAllToSVG(void *tkPtr, int threads, bool xmlDeclaration);
 const char *vrvToolkit_renderData(void *tkPtr, const char *data, const char *options);
 const char *vrvToolkit_renderToExpansionMap(void *tkPtr);
 bool vrvToolkit_renderToExpansionMapFile(void *tkPtr, const char *filename);
@@ -67,12 +72,15 @@ bool vrvToolkit_renderToTimemapFile(void *tkPtr, const char *filename, const cha
 void vrvToolkit_resetOptions(void *tkPtr);
 void vrvToolkit_resetXmlIdSeed(void *tkPtr, int seed);
 bool vrvToolkit_saveFile(void *tkPtr, const char *filename, const char *c_options);
+bool vrvToolkit_saveSnapshotFile(void *tkPtr, const char *filename);
 bool vrvToolkit_select(void *tkPtr, const char *selection);
 bool vrvToolkit_setInputFrom(void *tkPtr, const char *inputFrom);
 bool vrvToolkit_setOptions(void *tkPtr, const char *options);
 bool vrvToolkit_setOutputTo(void *tkPtr, const char *outputTo);
 bool vrvToolkit_setResourcePath(void *tkPtr, const char *path);
 bool vrvToolkit_setScale(void *tkPtr, int scale);
+void vrvToolkit_startProfiling(void *tkPtr);
+void vrvToolkit_stopProfiling(void *tkPtr);
 const char *vrvToolkit_validatePAE(void *tkPtr, const char *data);
 const char *vrvToolkit_validatePAEFile(void *tkPtr, const char *filename);
 
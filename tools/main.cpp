@@ -102,6 +102,7 @@ int main(int argc, char **argv)
         = { { &options->m_allPages, vrv::FromCamelCase(options->m_allPages.GetKey()) },
               { &options->m_inputFrom, vrv::FromCamelCase(options->m_inputFrom.GetKey()) },
               { &options->m_help, vrv::FromCamelCase(options->m_help.GetKey()) },
+              { &options->m_threads, vrv::FromCamelCase(options->m_threads.GetKey()) },
               { &options->m_logLevel, vrv::FromCamelCase(options->m_logLevel.GetKey()) },
               { &options->m_outfile, vrv::FromCamelCase(options->m_outfile.GetKey()) },
               { &options->m_page, vrv::FromCamelCase(options->m_page.GetKey()) },
@@ -115,6 +116,7 @@ int main(int argc, char **argv)
         optionStruct(&options->m_allPages, optionNames), //
         optionStruct(&options->m_inputFrom, optionNames), //
         optionStruct(&options->m_help, optionNames), //
+        optionStruct(&options->m_threads, optionNames), //
         optionStruct(&options->m_logLevel, optionNames), //
         optionStruct(&options->m_outfile, optionNames), //
         optionStruct(&options->m_page, optionNames), //
@@ -176,7 +178,7 @@ int main(int argc, char **argv)
     vrv::Option *opt = NULL;
     vrv::OptionBool *optBool = NULL;
     std::string resourcePath = toolkit.GetResourcePath();
-    while ((c = getopt_long(argc, argv, "ab:f:h:l:o:p:r:s:t:vx:z", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "ab:f:h:j:l:o:p:r:s:t:vx:z", long_options, &option_index)) != -1) {
         switch (c) {
             case 0:
                 key = long_options[option_index].name;
@@ -210,6 +212,12 @@ int main(int argc, char **argv)
                 };
                 break;
 
+            case 'j':
+                if (!options->m_threads.SetValue(optarg)) {
+                    vrv::LogWarning("Setting threads with %s failed, default value used", optarg);
+                }
+                break;
+
             case 'l': vrv::EnableLog(vrv::StrToLogLevel(std::string(optarg))); break;
 
             case 'o': outfile = std::string(optarg); break;
@@ -271,6 +279,11 @@ int main(int argc, char **argv)
         toolkit.InitClock();
     }
 
+    // Start profiling if desired
+    if (!options->m_profileTrace.GetValue().empty()) {
+        toolkit.StartProfiling();
+    }
+
     std::cerr << infile;
     if (optind <= argc - 1) {
         infile = std::string(argv[optind]);
@@ -296,11 +309,11 @@ int main(int argc, char **argv)
     }
 
     const std::vector<std::string> outformats = { "mei", "mei-basic", "mei-pb", "mei-facs", "svg", "midi", "timemap",
-        "expansionmap", "humdrum", "hum", "pae" };
+        "expansionmap", "humdrum", "hum", "pae", "snapshot" };
     if (std::find(outformats.begin(), outformats.end(), outformat) == outformats.end()) {
         std::cerr << "Output format (" << outformat
                   << ") can only be 'mei', 'mei-basic', 'mei-pb', mei-facs', 'svg', 'midi', 'timemap', 'expansionmap', "
-                     "'humdrum', 'hum', or 'pae'."
+                     "'humdrum', 'hum', 'pae', or 'snapshot'."
                   << std::endl;
         exit(1);
     }
@@ -368,6 +381,11 @@ int main(int argc, char **argv)
     }
 
     if (outformat == "svg") {
+        // All pages are rendered at once for drawing them concurrently
+        std::vector<std::string> svgPages;
+        if (all_pages) {
+            svgPages = toolkit.RenderAllToSVG(options->m_threads.GetValue(), !std_output);
+        }
         int p;
         for (p = from; p < to; ++p) {
             std::string cur_outfile = outfile;
@@ -376,9 +394,19 @@ int main(int argc, char **argv)
             }
             cur_outfile += ".svg";
             if (std_output) {
-                std::cout << toolkit.RenderToSVG(p);
+                std::cout << ((all_pages) ? svgPages.at(p - 1) : toolkit.RenderToSVG(p));
+                continue;
+            }
+            bool written = false;
+            if (all_pages) {
+                std::ofstream svgFile(cur_outfile.c_str());
+                svgFile << svgPages.at(p - 1);
+                written = svgFile.good();
             }
-            else if (!toolkit.RenderToSVGFile(cur_outfile, p)) {
+            else {
+                written = toolkit.RenderToSVGFile(cur_outfile, p);
+            }
+            if (!written) {
                 std::cerr << "Unable to write SVG to " << cur_outfile << "." << std::endl;
                 exit(1);
             }
@@ -552,6 +580,20 @@ int main(int argc, char **argv)
             }
         }
     }
+    else if (outformat == "snapshot") {
+        outfile += ".vrvs";
+        if (std_output) {
+            std::cerr << "Snapshot output cannot be written to standard output." << std::endl;
+            exit(1);
+        }
+        else if (!toolkit.SaveSnapshotFile(outfile)) {
+            std::cerr << "Unable to write snapshot to " << outfile << "." << std::endl;
+            exit(1);
+        }
+        else {
+            std::cerr << "Output written to " << outfile << "." << std::endl;
+        }
+    }
     else if (outformat == "pae") {
         outfile += ".pae";
         if (std_output) {
@@ -609,6 +651,18 @@ int main(int argc, char **argv)
         toolkit.LogRuntime();
     }
 
+    // Write the profile trace if desired
+    if (!options->m_profileTrace.GetValue().empty()) {
+        toolkit.StopProfiling();
+        std::ofstream traceFile(options->m_profileTrace.GetValue().c_str());
+        if (!traceFile.is_open()) {
+            std::cerr << "Unable to write profile trace to " << options->m_profileTrace.GetValue() << "." << std::endl;
+            exit(1);
+        }
+        traceFile << toolkit.GetProfileTrace();
+        std::cerr << "Profile trace written to " << options->m_profileTrace.GetValue() << "." << std::endl;
+    }
+
     free(long_options);
     return 0;
 }